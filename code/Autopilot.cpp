@@ -0,0 +1,119 @@
+/*
+ * AUTOPILOT
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#include <cmath>
+#include <basics/Timer>
+
+#include "Autopilot.hpp"
+
+using namespace basics;
+
+namespace flythecopter
+{
+
+    namespace
+    {
+        // Número de momentos distintos en los que puede cambiar de acción un plan. Con las dos
+        // acciones iniciales posibles hay el doble de ramas:
+        const unsigned switch_count = 8;
+    }
+
+    Autopilot::Autopilot
+    (
+        const Size2f & world_size,
+        const Size2f & player_size,
+        unsigned       lookahead_ticks,
+        unsigned       threads
+    )
+    :
+        branches    (switch_count * 2, world_size, player_size, 0, threads),
+        ticks       (switch_count * 2, 0),
+        survived    (switch_count * 2, 0)
+    {
+        lookahead      = lookahead_ticks > 0 ? lookahead_ticks : 1;
+        world_center   = world_size.height / 2.f;
+        decisions      = 0;
+        search_seconds = 0.0;
+
+        // Los cambios se concentran al principio, donde hace falta más precisión. El último plan no
+        // cambia nunca:
+
+        for (unsigned index = 1; index <= switch_count; ++index)
+        {
+            float    fraction = float(index) / switch_count;
+            unsigned tick     = unsigned(std::lround (lookahead * fraction * fraction));
+
+            switch_ticks.push_back (tick > 0 ? tick : 1);
+        }
+
+        branches.set_auto_restart (false);
+    }
+
+    bool Autopilot::decide (const Game_Simulation & simulation)
+    {
+        if (simulation.get_gameplay () != Game_Simulation::PLAYING)
+        {
+            return false;
+        }
+
+        Timer timer;
+
+        simulation.save (snapshot);
+
+        for (unsigned branch = 0, count = branches.size (); branch < count; ++branch)
+        {
+            branches.restore (branch, snapshot);
+
+            ticks   [branch] = 0;
+            survived[branch] = 0;
+        }
+
+        // Cada rama la lleva su plan. Se cuentan los pasos que empieza jugando (incluido el del choque):
+
+        branches.step
+        (
+            1.f / Game_Simulation::tick_rate,
+            lookahead,
+            [this] (unsigned branch, const Game_Simulation & simulation)
+            {
+                if (simulation.get_gameplay () == Game_Simulation::PLAYING) survived[branch]++;
+
+                bool first_action = (branch & 1) != 0;
+
+                return (ticks[branch]++ < switch_ticks[branch >> 1]) == first_action;
+            }
+        );
+
+        // Se elige la rama que sobrevive más pasos y, entre las que sobreviven lo mismo, la que
+        // termina más cerca del centro:
+
+        unsigned best          = 0;
+        float    best_distance = 0.f;
+
+        for (unsigned branch = 0, count = branches.size (); branch < count; ++branch)
+        {
+            Sprite_Store::Bounds bounds = branches.get (branch).get_player_bounds ();
+
+            float distance = std::abs ((bounds.bottom + bounds.top) / 2.f - world_center);
+
+            if (branch == 0 || survived[branch] > survived[best] || (survived[branch] == survived[best] && distance < best_distance))
+            {
+                best          = branch;
+                best_distance = distance;
+            }
+        }
+
+        decisions++;
+        search_seconds += timer.get_elapsed_seconds< double > ();
+
+        return (best & 1) != 0;
+    }
+
+}
@@ -0,0 +1,88 @@
+/*
+ * AUTOPILOT
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#ifndef AUTOPILOT_HEADER
+#define AUTOPILOT_HEADER
+
+    #include <vector>
+    #include <basics/Size>
+
+    #include "Game_Simulation.hpp"
+    #include "Simulation_Batch.hpp"
+
+    namespace flythecopter
+    {
+
+        /*
+         * Jugador automático para pruebas de larga duración. En cada paso copia el estado de la
+         * partida (con un Game_Simulation::Snapshot) en varias ramas y simula en paralelo unos
+         * cientos de milisegundos de cada una con un plan distinto: empezar subiendo o cayendo y
+         * cambiar después de un número de pasos distinto en cada rama. Decide lo que haga el plan que
+         * más tiempo sobrevive y, a igualdad, el que acaba más cerca del centro de la pantalla.
+         * Como la copia incluye el estado del generador aleatorio, las ramas ven los obstáculos que
+         * van a aparecer de verdad.
+         */
+        class Autopilot
+        {
+
+            Simulation_Batch          branches;         // Una partida por rama.
+            std::vector< unsigned >   switch_ticks;     // Paso en el que cambia de acción el plan de cada rama.
+            std::vector< unsigned >   ticks;            // Pasos simulados de cada rama en la búsqueda actual.
+            std::vector< unsigned >   survived;         // Pasos que ha sobrevivido cada rama en la búsqueda actual.
+
+            Game_Simulation::Snapshot snapshot;         // Estado de la partida desde el que se busca.
+            unsigned                  lookahead;        // Pasos que se simulan en cada rama.
+            float                     world_center;     // Altura del centro de la zona de juego.
+
+            unsigned                  decisions;        // Decisiones tomadas.
+            double                    search_seconds;   // Tiempo total dedicado a buscar.
+
+        public:
+
+            /*
+             * @param world_size Tamaño de la zona de juego (el de la resolución virtual de Game_Scene).
+             * @param player_size Tamaño del jugador (el de su textura).
+             * @param lookahead_ticks Pasos que se simulan hacia delante en cada decisión (30 son 500 ms).
+             * @param threads Número de hilos con los que se simulan las ramas (0 para usar todos los núcleos).
+             */
+            Autopilot
+            (
+                const basics::Size2f & world_size,
+                const basics::Size2f & player_size,
+                unsigned               lookahead_ticks = 30,
+                unsigned               threads         = 0
+            );
+
+            /*
+             * Decide si se debe tocar la pantalla en el siguiente paso de la partida.
+             */
+            bool decide (const Game_Simulation & simulation);
+
+            unsigned get_decision_count () const
+            {
+                return decisions;
+            }
+
+            unsigned get_branch_count () const
+            {
+                return branches.size ();
+            }
+
+            // Número de decisiones que se pueden tomar por segundo (teniendo en cuenta solo el tiempo de búsqueda).
+            double get_decisions_per_second () const
+            {
+                return search_seconds > 0.0 ? decisions / search_seconds : 0.0;
+            }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,224 @@
+/*
+ * CAVE TERRAIN
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "Cave_Terrain.hpp"
+
+using namespace basics;
+
+namespace flythecopter
+{
+
+    namespace
+    {
+        // Proporciones de la cueva respecto al alto de la zona de juego:
+
+        const float margin          = .035f;        // Grosor mínimo del suelo y del techo.
+        const float widest_gap      = .75f;         // Abertura máxima (la del principio).
+        const float initial_min_gap = .65f;         // Abertura mínima al empezar...
+        const float final_min_gap   = .40f;         // ...que se va reduciendo hasta esta.
+        const float narrowing_steps = 3000.f;       // Puntos generados hasta alcanzar la abertura mínima final (unos 2 minutos).
+
+        const float max_slope       = 6.f;          // Máxima variación de altura entre dos puntos (en px).
+        const float slope_change    = 2.f;
+        const float gap_change      = 8.f;
+    }
+
+    constexpr unsigned Cave_Terrain::capacity;
+    constexpr float    Cave_Terrain::column_width;
+    constexpr unsigned Cave_Terrain::history;
+    constexpr unsigned Cave_Terrain::mesh_vertex_count;
+
+    Cave_Terrain::Cave_Terrain(const Size2f & world_size)
+    :
+        world_width (world_size.width ),
+        world_height(world_size.height),
+        random      (1, 2)
+    {
+        reset ();
+    }
+
+    void Cave_Terrain::reset ()
+    {
+        // El primer punto se mantiene entre 'history' y 'history' + 1 columnas a la izquierda de la
+        // pantalla para poder retroceder sin que quede un hueco en el borde:
+
+        first     = 0;
+        scroll    = history * column_width;
+        slope     = 0.f;
+        generated = 0;
+
+        float floor   = world_height * (1.f - widest_gap) / 2.f;
+        float ceiling = world_height - floor;
+
+        std::fill (floors,   floors   + capacity, floor  );
+        std::fill (ceilings, ceilings + capacity, ceiling);
+    }
+
+    void Cave_Terrain::advance (float distance)
+    {
+        scroll = std::max (scroll + distance, 0.f);
+
+        // Cada punto que sale por la izquierda deja su hueco al que se genera por la derecha:
+
+        while (scroll >= (history + 1) * column_width)
+        {
+            unsigned index = first;
+
+            scroll -= column_width;
+            first   = at (1);
+
+            generate (index, at (capacity - 2));
+        }
+    }
+
+    void Cave_Terrain::generate (unsigned index, unsigned previous)
+    {
+        float center = (floors[previous] + ceilings[previous]) / 2.f;
+        float gap    =  ceilings[previous] - floors[previous];
+
+        float progress  = std::min (generated / narrowing_steps, 1.f);
+        float min_gap   = world_height * (initial_min_gap + (final_min_gap - initial_min_gap) * progress);
+        float thickness = world_height * margin;
+
+        // El centro sigue un camino aleatorio suavizado (se cambia la pendiente, no la altura) y la
+        // abertura varía un poco en cada punto:
+
+        slope  = std::min (std::max (slope + random.between (-slope_change, slope_change), -max_slope), max_slope);
+        gap    = std::min (std::max (gap   + random.between (-gap_change,   gap_change  ), min_gap), world_height * widest_gap);
+        center = center + slope;
+
+        // Al llegar arriba o abajo la cueva rebota:
+
+        float lowest  = thickness + gap / 2.f;
+        float highest = world_height - thickness - gap / 2.f;
+
+        if (center < lowest ) { center = lowest;  slope =  std::abs (slope) / 2.f; }
+        if (center > highest) { center = highest; slope = -std::abs (slope) / 2.f; }
+
+        floors  [index] = center - gap / 2.f;
+        ceilings[index] = center + gap / 2.f;
+
+        generated++;
+    }
+
+    void Cave_Terrain::sample (float position, float & floor, float & ceiling) const
+    {
+        float    clamped  = std::min (std::max (position, 0.f), float(capacity - 1));
+        unsigned offset   = std::min (unsigned(clamped), capacity - 2);
+        float    fraction = clamped - offset;
+
+        unsigned a = at (offset), b = at (offset + 1);
+
+        floor   = floors  [a] + (floors  [b] - floors  [a]) * fraction;
+        ceiling = ceilings[a] + (ceilings[b] - ceilings[a]) * fraction;
+    }
+
+    bool Cave_Terrain::collides (const Bounds & box, float shift) const
+    {
+        // Como el terreno es lineal entre puntos, sus extremos bajo la caja están en sus bordes o en
+        // alguno de los puntos que quedan entre ellos:
+
+        float start = (box.left  - shift + scroll) / column_width;
+        float end   = (box.right - shift + scroll) / column_width;
+
+        float highest_floor, lowest_ceiling, floor, ceiling;
+
+        sample (start, highest_floor, lowest_ceiling);
+        sample (end,   floor,         ceiling       );
+
+        highest_floor  = std::max (highest_floor,  floor  );
+        lowest_ceiling = std::min (lowest_ceiling, ceiling);
+
+        unsigned last = unsigned(std::min (std::max (end, 0.f), float(capacity - 1)));
+
+        for (unsigned offset = start < 0.f ? 0 : unsigned(start) + 1; offset <= last; ++offset)
+        {
+            highest_floor  = std::max (highest_floor,  floors  [at (offset)]);
+            lowest_ceiling = std::min (lowest_ceiling, ceilings[at (offset)]);
+        }
+
+        return box.bottom < highest_floor || box.top > lowest_ceiling;
+    }
+
+    void Cave_Terrain::get_gap (float x, float & floor, float & ceiling) const
+    {
+        sample ((x + scroll) / column_width, floor, ceiling);
+    }
+
+    unsigned Cave_Terrain::build_mesh (Point2f * vertices, float shift) const
+    {
+        // Solo se incluyen los puntos desde el último que queda fuera de la pantalla por la izquierda
+        // hasta el primero que queda fuera por la derecha:
+
+        unsigned begin = std::min (unsigned(std::max (std::floor ((scroll + shift) / column_width), 0.f)), capacity - 2);
+        unsigned count = std::min (unsigned(std::ceil ((world_width + scroll + shift) / column_width)) + 1, capacity);
+        unsigned total = 0;
+
+        float x0 = -scroll - shift;
+
+        for (unsigned offset = begin; offset < count; ++offset)
+        {
+            float x = x0 + offset * column_width;
+
+            vertices[total++] = { x, 0.f };
+            vertices[total++] = { x, floors[at (offset)] };
+        }
+
+        // Dos vértices repetidos unen el suelo con el techo sin dibujar nada entre ellos:
+
+        vertices[total] = vertices[total - 1]; total++;
+        vertices[total++] = { x0 + begin * column_width, ceilings[at (begin)] };
+
+        for (unsigned offset = begin; offset < count; ++offset)
+        {
+            float x = x0 + offset * column_width;
+
+            vertices[total++] = { x, ceilings[at (offset)] };
+            vertices[total++] = { x, world_height };
+        }
+
+        return total;
+    }
+
+    void Cave_Terrain::save (State & state) const
+    {
+        state.random    = random.get_state ();
+        state.scroll    = scroll;
+        state.slope     = slope;
+        state.generated = generated;
+
+        for (unsigned offset = 0; offset < capacity; ++offset)
+        {
+            state.floors  [offset] = floors  [at (offset)];
+            state.ceilings[offset] = ceilings[at (offset)];
+        }
+    }
+
+    bool Cave_Terrain::restore (const State & state)
+    {
+        if (!(state.scroll >= 0.f && state.scroll < (history + 1) * column_width)) return false;
+
+        random.set_state (state.random);
+
+        first     = 0;
+        scroll    = state.scroll;
+        slope     = state.slope;
+        generated = state.generated;
+
+        std::copy (state.floors,   state.floors   + capacity, floors  );
+        std::copy (state.ceilings, state.ceilings + capacity, ceilings);
+
+        return true;
+    }
+
+}
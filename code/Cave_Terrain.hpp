@@ -0,0 +1,134 @@
+/*
+ * CAVE TERRAIN
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#ifndef CAVE_TERRAIN_HEADER
+#define CAVE_TERRAIN_HEADER
+
+    #include <cstdint>
+    #include <basics/Point>
+    #include <basics/Random>
+    #include <basics/Size>
+
+    #include "Sprite_Store.hpp"
+
+    namespace flythecopter
+    {
+
+        using basics::Random;
+
+        /*
+         * Suelo y techo continuos de una cueva que se desplaza hacia la izquierda. El terreno se
+         * describe con la altura del suelo y del techo en puntos separados 'column_width' en X
+         * (entre dos puntos se interpola linealmente). Los puntos se guardan en un anillo de tamaño
+         * fijo: cuando un punto lleva 'history' columnas fuera de la pantalla por la izquierda su
+         * hueco se reutiliza para generar uno nuevo por la derecha, de modo que la memoria no crece
+         * por mucho que dure la partida. Los puntos que se conservan a la izquierda permiten
+         * retroceder la cueva al momento de un choque dentro de un paso largo.
+         * Como los puntos están equiespaciados, el que corresponde a una X se calcula directamente,
+         * así que comprobar si una caja choca con el terreno solo examina los puntos que hay bajo
+         * ella, sin recorrer nada más.
+         */
+        class Cave_Terrain
+        {
+        public:
+
+            typedef Sprite_Store::Bounds Bounds;
+
+            static constexpr unsigned capacity     = 128;       // Puntos del anillo (potencia de 2). Cubren 2048 px.
+            static constexpr float    column_width = 16.f;      // Distancia en X entre dos puntos consecutivos.
+            static constexpr unsigned history      = 32;        // Puntos que se conservan fuera de la pantalla por la izquierda (512 px, 1,28 s a 400 px/s).
+
+            // Estado completo del terreno (con los puntos ordenados de izquierda a derecha) para Game_Simulation::Snapshot.
+            struct State
+            {
+                Random::State random;
+                float         scroll;
+                float         slope;
+                uint32_t      generated;
+                float         floors  [capacity];
+                float         ceilings[capacity];
+            };
+
+        private:
+
+            float    floors  [capacity];            // Altura del suelo en cada punto.
+            float    ceilings[capacity];            // Altura del techo en cada punto.
+            unsigned first;                         // Posición en el anillo del punto situado más a la izquierda.
+            float    scroll;                        // Distancia desde ese punto hasta el borde izquierdo de la pantalla.
+            float    slope;                         // Desplazamiento vertical del centro de la cueva entre dos puntos.
+            uint32_t generated;                     // Puntos generados desde reset() (la cueva se estrecha con ellos).
+
+            float    world_width;
+            float    world_height;
+
+            Random   random;                        // Generador propio para que la forma de la cueva no dependa de los obstáculos.
+
+        public:
+
+            Cave_Terrain(const basics::Size2f & world_size);
+
+            void set_seed (uint64_t seed)
+            {
+                random.set_seed (seed, 2);
+            }
+
+            // Vuelve a llenar el anillo con una cueva recta y ancha (la del principio de la partida).
+            void reset ();
+
+            /*
+             * Desplaza la cueva hacia la izquierda generando los puntos nuevos que hagan falta. Con una
+             * distancia negativa retrocede sin deshacer lo generado, como mucho hasta que el primer
+             * punto conservado llega al borde izquierdo (al menos 'history' - 1 columnas).
+             */
+            void advance (float distance);
+
+            /*
+             * Comprueba si una caja toca el suelo o el techo.
+             * @param shift Desplazamiento en X de la cueva respecto a su posición actual (positivo hacia
+             *     la derecha). Sirve para comprobar dónde estaba la cueva en un momento anterior del paso.
+             */
+            bool collides (const Bounds & box, float shift = 0.f) const;
+
+            // Alturas del suelo y del techo en una X de la pantalla.
+            void get_gap (float x, float & floor, float & ceiling) const;
+
+            /*
+             * Escribe los vértices de una única tira de triángulos (GL_TRIANGLE_STRIP) que dibuja el
+             * suelo y el techo. Entre ambos se repiten dos vértices para unirlos con triángulos vacíos.
+             * @param vertices Array con espacio para mesh_vertex_count vértices.
+             * @param shift Desplazamiento en X adicional (para adelantar el dibujo una fracción de paso).
+             * @return Número de vértices escritos.
+             */
+            unsigned build_mesh (basics::Point2f * vertices, float shift = 0.f) const;
+
+            static constexpr unsigned mesh_vertex_count = capacity * 4 + 2;
+
+            void save    (State & state) const;
+            bool restore (const State & state);
+
+        private:
+
+            // Índice en el anillo del punto que ocupa la posición 'offset' contando desde el primero.
+            unsigned at (unsigned offset) const
+            {
+                return (first + offset) & (capacity - 1);
+            }
+
+            // Genera el punto que sigue al último escribiendo sus alturas en la posición 'index' del anillo.
+            void generate (unsigned index, unsigned previous);
+
+            // Alturas interpoladas en la posición 'position' (medida en puntos desde el primero).
+            void sample (float position, float & floor, float & ceiling) const;
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,223 @@
+/*
+ * COLLISION INDEX
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "Collision_Index.hpp"
+
+namespace flythecopter
+{
+
+    void Collision_Index::update (const Sprite_Store & store)
+    {
+        const uint32_t * slots      = store.get_slots      ();
+        const uint8_t  * visibility = store.get_visibility ();
+
+        update_count++;
+
+        if (stamps.size () < store.get_slot_count ())
+        {
+            stamps.resize (store.get_slot_count (), 0);
+        }
+
+        // Se conservan en su orden anterior las entradas cuyo slot sigue ocupado, leyendo sus cajas
+        // actualizadas:
+
+        unsigned kept = 0;
+
+        for (unsigned entry = 0, count = size (); entry < count; ++entry)
+        {
+            uint32_t slot  = entries[entry].slot;
+            unsigned index = store.index_of_slot (slot);
+
+            if (index != Sprite_Store::npos && visibility[index])
+            {
+                entries[kept++] = { store.get_bounds_at (index), slot, index };
+                stamps [slot  ] = update_count;
+            }
+        }
+
+        entries.resize (kept);
+
+        // Se añaden al final los sprites que no estaban en el índice:
+
+        for (unsigned index = 0, count = store.size (); index < count; ++index)
+        {
+            if (visibility[index] && stamps[slots[index]] != update_count)
+            {
+                entries.push_back ({ store.get_bounds_at (index), slots[index], index });
+
+                stamps[slots[index]] = update_count;
+            }
+        }
+
+        // Las entradas conservadas ya estaban casi ordenadas, por lo que se reordenan por inserción con
+        // coste lineal. Las nuevas se ordenan aparte y, como normalmente aparecen por la derecha, basta
+        // con ponerlas detrás. Si alguna aparece a la izquierda se reordena todo:
+
+        auto compare = [] (const Entry & a, const Entry & b) { return a.bounds.left < b.bounds.left; };
+
+        for (unsigned entry = 1; entry < kept; ++entry)
+        {
+            Entry    moved = entries[entry];
+            unsigned place = entry;
+
+            while (place > 0 && entries[place - 1].bounds.left > moved.bounds.left)
+            {
+                entries[place] = entries[place - 1];
+                place--;
+            }
+
+            entries[place] = moved;
+        }
+
+        std::sort (entries.begin () + kept, entries.end (), compare);
+
+        if (kept > 0 && kept < size () && compare (entries[kept], entries[kept - 1]))
+        {
+            std::sort (entries.begin (), entries.end (), compare);
+        }
+
+        // Se copian las cajas ordenadas a los arrays empaquetados que usa la fase estrecha:
+
+        lefts  .resize (size ());
+        bottoms.resize (size ());
+        rights .resize (size ());
+        tops   .resize (size ());
+
+        const float * speeds_x = store.get_speeds_x ();
+        const float * speeds_y = store.get_speeds_y ();
+
+        max_width   = 0.f;
+        max_speed_x = 0.f;
+        max_speed_y = 0.f;
+
+        for (unsigned entry = 0, count = size (); entry < count; ++entry)
+        {
+            const Bounds & bounds = entries[entry].bounds;
+            unsigned       index  = entries[entry].index;
+
+            lefts  [entry] = bounds.left;
+            bottoms[entry] = bounds.bottom;
+            rights [entry] = bounds.right;
+            tops   [entry] = bounds.top;
+
+            max_width   = std::max (max_width,   bounds.right - bounds.left);
+            max_speed_x = std::max (max_speed_x, std::abs (speeds_x[index]));
+            max_speed_y = std::max (max_speed_y, std::abs (speeds_y[index]));
+        }
+    }
+
+    void Collision_Index::find_candidates (const Bounds & bounds, unsigned & first, unsigned & last) const
+    {
+        // Una caja solo puede solaparse si su borde izquierdo está entre (left - max_width) y right:
+
+        auto begin = lefts.begin ();
+        auto lower = std::upper_bound (begin, lefts.end (), bounds.left - max_width);
+        auto upper = std::lower_bound (lower, lefts.end (), bounds.right);
+
+        first = unsigned(lower - begin);
+        last  = unsigned(upper - begin);
+    }
+
+    unsigned Collision_Index::find_overlap (const Bounds & bounds) const
+    {
+        unsigned first, last;
+
+        find_candidates (bounds, first, last);
+
+        box_tests += last - first;
+
+        unsigned found = find_first_overlap (bounds, get_packed_bounds (first), last - first);
+
+        return found == Sprite_Store::npos ? found : entries[first + found].index;
+    }
+
+    void Collision_Index::find_overlaps (const Bounds & bounds, std::vector< unsigned > & overlaps) const
+    {
+        unsigned first, last;
+
+        find_candidates (bounds, first, last);
+
+        collect_overlaps (bounds, first, last, [&] (unsigned entry) { overlaps.push_back (entries[entry].index); });
+    }
+
+    void Collision_Index::find_pairs (std::vector< Pair > & pairs) const
+    {
+        // Barrido: como las entradas están ordenadas por el borde izquierdo, cada caja solo puede
+        // solaparse con las siguientes hasta la primera que empieza después de su borde derecho:
+
+        for (unsigned a = 0, count = size (); a < count; ++a)
+        {
+            const Bounds & bounds = entries[a].bounds;
+
+            unsigned last = unsigned(std::lower_bound (lefts.begin () + a + 1, lefts.end (), bounds.right) - lefts.begin ());
+
+            collect_overlaps (bounds, a + 1, last, [&] (unsigned b) { pairs.push_back ({ entries[a].index, entries[b].index }); });
+        }
+    }
+
+    unsigned Collision_Index::find_first_impact
+    (
+        const Sprite_Store & store,
+        const Bounds       & start,
+        float                dx,
+        float                dy,
+        float                time,
+        float              & time_of_impact
+    ) const
+    {
+        // Visto desde un sprite del índice (parado en su posición final), la caja empieza desplazada
+        // lo mismo que se movió el sprite y acaba en su posición final. Como cada sprite se mueve a
+        // su velocidad, se buscan candidatos en la zona que cubre el recorrido con el mayor
+        // desplazamiento posible:
+
+        float reach_x = max_speed_x * time;
+        float reach_y = max_speed_y * time;
+
+        Bounds area
+        {
+            std::min (start.left   - reach_x, start.left   + dx),
+            std::min (start.bottom - reach_y, start.bottom + dy),
+            std::max (start.right  + reach_x, start.right  + dx),
+            std::max (start.top    + reach_y, start.top    + dy),
+        };
+
+        unsigned first, last, found = Sprite_Store::npos;
+
+        find_candidates (area, first, last);
+
+        const float * speeds_x = store.get_speeds_x ();
+        const float * speeds_y = store.get_speeds_y ();
+
+        collect_overlaps (area, first, last, [&] (unsigned entry)
+        {
+            // Se prueba el movimiento relativo contra la caja que tenía el sprite al principio del paso:
+
+            unsigned index = entries[entry].index;
+            float    ox    = speeds_x[index] * time;
+            float    oy    = speeds_y[index] * time;
+            Bounds   box   = entries[entry].bounds;
+            float    impact;
+
+            box.left  -= ox; box.bottom -= oy;
+            box.right -= ox; box.top    -= oy;
+
+            if (Sprite_Store::sweep (start, dx - ox, dy - oy, box, impact) && (found == Sprite_Store::npos || impact < time_of_impact))
+            {
+                found          = index;
+                time_of_impact = impact;
+            }
+        });
+
+        return found;
+    }
+
+}
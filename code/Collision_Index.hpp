@@ -0,0 +1,200 @@
+/*
+ * COLLISION INDEX
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#ifndef COLLISION_INDEX_HEADER
+#define COLLISION_INDEX_HEADER
+
+    #include <cstdint>
+    #include <vector>
+
+    #include "Overlap_Kernel.hpp"
+    #include "Sprite_Store.hpp"
+
+    namespace flythecopter
+    {
+
+        /*
+         * Fase amplia (broadphase) de detección de colisiones por barrido y poda sobre el eje X.
+         * Las cajas envolventes de los sprites de un Sprite_Store se guardan ordenadas por su borde
+         * izquierdo, de modo que una consulta solo examina los sprites cuyo intervalo en X puede
+         * solaparse con el buscado. La prueba exacta de las cajas (fase estrecha) se hace después
+         * solo con esos candidatos.
+         * El orden del fotograma anterior se conserva entre actualizaciones. Como los obstáculos se
+         * desplazan todos hacia la izquierda a la misma velocidad, su orden relativo no cambia y los
+         * nuevos aparecen por la derecha, así que reordenar por inserción cuesta O(n).
+         * Tras ordenar, las cajas se copian a arrays empaquetados (uno por borde) para que la fase
+         * estrecha compruebe varios candidatos a la vez con find_overlap_mask().
+         */
+        class Collision_Index
+        {
+        public:
+
+            typedef Sprite_Store::Bounds Bounds;
+
+            // Pareja de sprites que se solapan (índices densos en el almacén).
+            struct Pair
+            {
+                unsigned a;
+                unsigned b;
+            };
+
+        private:
+
+            struct Entry
+            {
+                Bounds   bounds;
+                uint32_t slot;
+                unsigned index;
+            };
+
+            std::vector< Entry    > entries;        // Cajas de los sprites visibles ordenadas por su borde izquierdo.
+            std::vector< float    > lefts;          // Bordes de las cajas de 'entries' en el mismo orden.
+            std::vector< float    > bottoms;
+            std::vector< float    > rights;
+            std::vector< float    > tops;
+            std::vector< uint32_t > stamps;         // Última actualización en la que se incluyó cada slot.
+            uint32_t                update_count;   // Número de actualizaciones hechas.
+            float                   max_width;      // Anchura de la caja más ancha del índice.
+            float                   max_speed_x;    // Mayor velocidad horizontal (en valor absoluto) de los sprites del índice.
+            float                   max_speed_y;    // Mayor velocidad vertical   (en valor absoluto) de los sprites del índice.
+
+            mutable uint64_t        box_tests;      // Cajas comparadas en la fase estrecha desde reset_box_tests().
+
+        public:
+
+            Collision_Index()
+            {
+                update_count = 0;
+                max_width    = 0.f;
+                max_speed_x  = 0.f;
+                max_speed_y  = 0.f;
+                box_tests    = 0;
+            }
+
+            /*
+             * Reserva memoria para que actualizar el índice de un almacén de hasta 'capacity' sprites
+             * no necesite reservar más.
+             */
+            void reserve (unsigned capacity)
+            {
+                entries.reserve (capacity);
+                lefts  .reserve (capacity);
+                bottoms.reserve (capacity);
+                rights .reserve (capacity);
+                tops   .reserve (capacity);
+                stamps .reserve (capacity);
+            }
+
+            unsigned size () const
+            {
+                return unsigned(entries.size ());
+            }
+
+            // Número de cajas comparadas en la fase estrecha por las consultas hechas desde reset_box_tests().
+            uint64_t get_box_tests () const
+            {
+                return box_tests;
+            }
+
+            void reset_box_tests ()
+            {
+                box_tests = 0;
+            }
+
+            /*
+             * Vuelve a leer las cajas envolventes de los sprites visibles del almacén y reordena el índice.
+             * Debe llamarse cada vez que los sprites se muevan, se creen o se eliminen y antes de consultar.
+             */
+            void update (const Sprite_Store & store);
+
+            /*
+             * Busca un sprite del índice cuya caja se solape con la indicada.
+             * @return El índice denso del sprite en el almacén o Sprite_Store::npos si no hay ninguno.
+             */
+            unsigned find_overlap (const Bounds & bounds) const;
+
+            /*
+             * Añade a 'overlaps' los índices densos de todos los sprites cuya caja se solapa con la indicada.
+             */
+            void find_overlaps (const Bounds & bounds, std::vector< unsigned > & overlaps) const;
+
+            /*
+             * Añade a 'pairs' todas las parejas de sprites del índice cuyas cajas se solapan entre sí.
+             */
+            void find_pairs (std::vector< Pair > & pairs) const;
+
+            /*
+             * Detección continua: busca el sprite del índice con el que antes choca una caja que se
+             * desplaza (dx, dy) durante un paso de 'time' segundos en el que los sprites del almacén
+             * también se han movido según su velocidad. El índice debe estar actualizado con las
+             * posiciones del final del paso. Así no se pierden choques aunque el paso sea tan largo
+             * que las cajas se atraviesen sin llegar a solaparse al final.
+             * @param time_of_impact Fracción del paso (entre 0 y 1) en la que se produce el choque.
+             * @return El índice denso del sprite en el almacén o Sprite_Store::npos si no choca con ninguno.
+             */
+            unsigned find_first_impact
+            (
+                const Sprite_Store & store,
+                const Bounds       & start,
+                float                dx,
+                float                dy,
+                float                time,
+                float              & time_of_impact
+            ) const;
+
+        private:
+
+            // Devuelve el rango [first, last) de entradas cuyo intervalo en X puede solaparse con el de 'bounds'.
+            void find_candidates (const Bounds & bounds, unsigned & first, unsigned & last) const;
+
+            /*
+             * Llama a 'found' con cada entrada del rango [first, last) cuya caja se solapa con 'bounds'.
+             * Los candidatos se comprueban por bloques con una máscara en la pila para no reservar memoria.
+             */
+            template< typename FUNCTION >
+            void collect_overlaps (const Bounds & bounds, unsigned first, unsigned last, FUNCTION found) const
+            {
+                static constexpr unsigned block_size = 256;
+
+                uint32_t mask[block_size / 32];
+
+                box_tests += last - first;
+
+                for (unsigned block = first; block < last; block += block_size)
+                {
+                    unsigned count = last - block < block_size ? last - block : block_size;
+
+                    if (find_overlap_mask (bounds, get_packed_bounds (block), count, mask) == 0) continue;
+
+                    for (unsigned word = 0, words = overlap_mask_words (count); word < words; ++word)
+                    {
+                        for (uint32_t bits = mask[word]; bits; bits &= bits - 1)
+                        {
+                            unsigned bit = 0;
+
+                            while (!(bits & (1u << bit))) bit++;
+
+                            found (block + word * 32 + bit);
+                        }
+                    }
+                }
+            }
+
+            // Devuelve las cajas empaquetadas a partir de la entrada 'first'.
+            Packed_Bounds get_packed_bounds (unsigned first) const
+            {
+                return { lefts.data () + first, bottoms.data () + first, rights.data () + first, tops.data () + first };
+            }
+
+        };
+
+    }
+
+#endif
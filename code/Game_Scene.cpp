@@ -11,41 +11,51 @@
 #include "Game_Scene.hpp"
 #include "Menu_Scene.hpp"
 
-#include <cstdlib>
+#include <cstring>
+#include <basics/Application>
 #include <basics/Canvas>
 #include <basics/Director>
+#include <basics/Log>
 
 using namespace basics;
 using namespace std;
 
 namespace flythecopter
 {
-    // ID y ruta de las texturas que se deben cargar para esta escena. La textura con el mensaje de
-    // carga está la primera para poder dibujarla cuanto antes:
+    // Se establece la resolución virtual (independiente de la resolución virtual del dispositivo).
+    // En este caso no se hace ajuste de aspect ratio, por lo que puede haber distorsión cuando
+    // el aspect ratio real de la pantalla del dispositivo es distinto.
 
-    Game_Scene::Texture_Data Game_Scene::textures_data[] =
-            {
-                { ID(loading),"game-scene/loading.png"},
-                { ID(copter),"game-scene/helicoptero.png"},
-                { ID(wall),"game-scene/wall.png"},
-            };
+    Game_Scene::Game_Scene()
+    :
+        canvas_width (1280),
+        canvas_height( 720),
+        simulation   ({ 1280.f, 720.f })
+    {
+        // La simulación avanza en pasos fijos para que se comporte igual a 30, 60 o 120 fps:
+        set_fixed_tick_rate (Game_Simulation::tick_rate);
 
-    // Para determinar el número de items en el array textures_data, se divide el tamaño en bytes
-    // del array completo entre el tamaño en bytes de un item:
-    unsigned Game_Scene::textures_count = sizeof(textures_data) / sizeof(Texture_Data);
+        // Se dibuja como mucho a 60 fps (en pantallas más rápidas se gastaría batería sin mejorar nada):
+        set_frame_rate (60);
 
+        // Cada partida pide a Director una semilla distinta para que los obstáculos y la cueva cambien.
+        // Al reproducir una grabación, Director vuelve a dar las mismas semillas que cuando se grabó
+        // (se puede fijar después con set_seed()):
+        simulation.set_seed (director.next_seed ());
 
+        // Se juega dentro de la cueva. Sus vértices se reservan una vez para no reservar memoria al dibujar:
+        simulation.set_cave (true);
 
-    Game_Scene::Game_Scene()
-    {
-        // Se establece la resolución virtual (independiente de la resolución virtual del dispositivo).
-        // En este caso no se hace ajuste de aspect ratio, por lo que puede haber distorsión cuando
-        // el aspect ratio real de la pantalla del dispositivo es distinto.
-        canvas_width  = 1280;
-        canvas_height =  720;
+        terrain_mesh.resize (Cave_Terrain::mesh_vertex_count);
+
+        autopilot_enabled = false;
+        autopilot_games   = 0;
 
-        // Se inicia la semilla del generador de números aleatorios:
-        srand (unsigned(time(nullptr)));
+        CopterLogo_slice = BackButton_slice = StopButton_slice = Continue_slice = nullptr;
+
+        // La partida guardada se copia ahora porque Director puede llamar a suspend() (que cambia el
+        // estado guardado) antes de que termine la carga:
+        has_saved_game_to_restore = read_saved_game (saved_game);
 
         // Se inicializan otros atributos:
         initialize ();
@@ -59,16 +69,39 @@ namespace flythecopter
     {
         state     = LOADING;
         suspended = true;
-        gameplay  = UNINITIALIZED;
+
+        interpolation = 0.f;
+        loading_time  = 0.f;
+
+        autopilot_pending = false;
 
         return true;
     }
 
 
 
+    // Al pasar a segundo plano se guarda la partida por si el sistema cierra la aplicación y se pausa
+    // para que al volver el jugador no pierda sin tener tiempo de reaccionar.
     void Game_Scene::suspend ()
     {
         suspended = true;               // Se marca que la escena ha pasado a segundo plano
+
+        if ((state == RUNNING || state == PAUSED) && simulation.get_gameplay () == Game_Simulation::PLAYING)
+        {
+            Game_Simulation::Snapshot snapshot;
+
+            simulation.save (snapshot);
+
+            application.set_saved_state (&snapshot, sizeof(snapshot));
+
+            state = PAUSED;
+        }
+        else if (state == RUNNING || state == PAUSED)
+        {
+            // La partida no ha empezado o ya ha terminado. Mientras se carga (o si la carga ha fallado)
+            // se mantiene el estado guardado, que puede ser el de una partida pendiente de recuperar:
+            application.clear_saved_state ();
+        }
     }
 
 
@@ -80,12 +113,54 @@ namespace flythecopter
 
 
 
+    // Al salir de la escena la partida ha terminado, por lo que ya no hay nada que recuperar.
+    void Game_Scene::finalize ()
+    {
+        application.clear_saved_state ();
+    }
+
+
+
+    bool Game_Scene::has_saved_game ()
+    {
+        Game_Simulation::Snapshot snapshot;
+
+        return read_saved_game (snapshot);
+    }
+
+
+
+    bool Game_Scene::read_saved_game (Game_Simulation::Snapshot & snapshot)
+    {
+        std::vector< uint8_t > saved_state = application.get_saved_state ();
+
+        if (saved_state.size () == sizeof(snapshot))
+        {
+            std::memcpy (&snapshot, saved_state.data (), sizeof(snapshot));
+
+            return snapshot.version == Game_Simulation::Snapshot::current_version;
+        }
+
+        return false;
+    }
+
+
+
     void Game_Scene::handle (Event & event)
     {
+        // Solo el toque enviado por el piloto automático permite que envíe el siguiente:
+
+        var::Int32 * touch_id        = event[ID(id)].as< var::Int32 > ();
+        bool         autopilot_touch = touch_id && int32_t(*touch_id) == autopilot_touch_id;
+
+        if (autopilot_touch) autopilot_pending = false;
+
         if (state == RUNNING)               // Se descartan los eventos cuando la escena está LOADING
         {
-            if (gameplay == GAME_OVER){     // En caso de tocar la pantalla una vez hayas perdido, vuelves al menu inicial
-                switch (event.id) {
+            if (simulation.get_gameplay () == Game_Simulation::GAME_OVER){     // En caso de tocar la pantalla una vez hayas perdido, vuelves al menu inicial
+                // Un toque del piloto automático puede llegar después de perder en otro paso del mismo
+                // fotograma. Se ignora porque el piloto automático vuelve a empezar él solo:
+                if (!autopilot_touch) switch (event.id) {
                     case ID(touch-ended):
                     {
                         director.run_scene(shared_ptr<Scene>(new Menu_Scene));
@@ -93,20 +168,20 @@ namespace flythecopter
                     }
                 }
             }
-            else if (gameplay == WAITING_TO_START)
+            else if (simulation.get_gameplay () == Game_Simulation::WAITING_TO_START)
             {
-                start_playing ();           // Se empieza a jugar cuando el usuario toca la pantalla por primera vez
+                simulation.start_playing ();           // Se empieza a jugar cuando el usuario toca la pantalla por primera vez
             }
             else switch (event.id)
                 {
                     case ID(touch-started):         // El usuario toca la pantalla
                     {
-                        flying = true;
+                        simulation.set_flying (true);
                         break;
                     }
                     case ID(touch-moved):
                     {
-                        flying = true;
+                        simulation.set_flying (true);
                         break;
                     }
 
@@ -116,7 +191,7 @@ namespace flythecopter
                         if((*event[ID(x)].as< var::Float > ()) > canvas_width - 200 && (*event[ID(y)].as< var::Float > ()) > canvas_height - 150){
                             state = PAUSED;
                         }else{
-                            flying = false;
+                            simulation.set_flying (false);
                         }
 
                         break;
@@ -133,13 +208,76 @@ namespace flythecopter
     {
         if (!suspended) switch (state)
             {
-                case LOADING: load_textures  ();     break;
+                case LOADING: loading_time += time; load_textures (); break;
                 case PAUSED: break;
-                case RUNNING: run_simulation (time); break;
+                case RUNNING:
+                {
+                    simulation.step (time);
+
+                    if (autopilot_enabled) drive_autopilot ();
+
+                    break;
+                }
                 case ERROR:   break;
             }
     }
 
+    // El piloto automático juega a través de Director como lo haría el usuario, de modo que sus toques pasan
+    // por el mismo camino (y se graban si se está grabando la entrada). Los toques se envían en la esquina
+    // superior izquierda, lejos del botón de pausa. Mientras no llega el último toque enviado no se envía
+    // otro, ya que puede haber varios pasos por fotograma.
+    void Game_Scene::drive_autopilot ()
+    {
+        if (autopilot_pending) return;
+
+        if (!autopilot)
+        {
+            Sprite_Store::Bounds player = simulation.get_player_bounds ();
+
+            autopilot.reset (new Autopilot({ float(canvas_width), float(canvas_height) }, { player.right - player.left, player.top - player.bottom }));
+        }
+
+        bool touch;
+
+        switch (simulation.get_gameplay ())
+        {
+            case Game_Simulation::WAITING_TO_START: touch = true;                           break;
+            case Game_Simulation::PLAYING:          touch = autopilot->decide (simulation); break;
+
+            case Game_Simulation::GAME_OVER:
+            {
+                basics::log.i ("autopilot: " + to_string (unsigned(autopilot->get_decisions_per_second ())) + " decisions/s, " +
+                              to_string (autopilot->get_decision_count ()) + " decisions so far");
+
+                simulation.restart ();
+                autopilot_games++;
+                return;
+            }
+
+            default: return;
+        }
+
+        if (simulation.get_gameplay () == Game_Simulation::PLAYING && touch == simulation.is_flying ()) return;
+
+        Event event(touch ? ID(touch-started) : ID(touch-ended));
+
+        event[ID(id)] = int32_t(autopilot_touch_id);
+        event[ID(x) ] = 0.f;
+        event[ID(y) ] = 0.f;
+
+        director.handle (event);
+
+        autopilot_pending = true;
+    }
+
+    // Como la simulación avanza en pasos fijos, al dibujar puede haber pasado parte del siguiente paso.
+    void Game_Scene::render (Context & context, float alpha)
+    {
+        interpolation = alpha;
+
+        render (context);
+    }
+
     // Este método se invoca automáticamente una vez por fotograma para que la escena dibuje su contenido.
     void Game_Scene::render (Context & context)
     {
@@ -158,6 +296,10 @@ namespace flythecopter
 
             if (canvas)
             {
+                // Los quads texturizados se agrupan por textura y se dibujan con una sola llamada a
+                // la GPU por lote en lugar de una por sprite:
+                canvas->set_batching (true);
+
                 canvas->clear ();
 
                 switch (state)
@@ -179,7 +321,7 @@ namespace flythecopter
     // un tiempo.
     void Game_Scene::load_textures ()
     {
-        if (textures.size () < textures_count)          // Si quedan texturas por cargar...
+        if (!loading_texture || !atlas)                 // Si quedan texturas por cargar...
         {
             // Las texturas se cargan y se suben al contexto gráfico, por lo que es necesario disponer
             // de uno:
@@ -188,182 +330,68 @@ namespace flythecopter
 
             if (context)
             {
-                // Se carga la siguiente textura (textures.size() indica cuántas llevamos cargadas):
-                Texture_Data   & texture_data = textures_data[textures.size ()];
-                Texture_Handle & texture      = textures[texture_data.id] = Texture_2D::create (texture_data.id, context, texture_data.path);
+                if (!loading_texture)
+                {
+                    // Primero se carga la textura con el mensaje de carga:
+                    loading_texture = Texture_2D::create (ID(loading), context, "game-scene/loading.png");
 
-                // Se comprueba si la textura se ha podido cargar correctamente:
-                if (texture) context->add (texture); else state = ERROR;
+                    if (loading_texture) context->add (loading_texture); else state = ERROR;
+                }
+                else
+                {
+                    // Después el resto de imágenes, que están todas juntas en un atlas para que los
+                    // sprites y los botones se dibujen sin cambiar de textura (los ids son los que
+                    // se indican al generarlo en el target atlases de project/linux):
+                    atlas.reset (new Atlas("atlases/game-scene.atlas", context));
 
-                BackButton_texture = Texture_2D::create (0, context, "volverMenu.png");
-                CopterLogo_texture = Texture_2D::create (0, context, "CopterLogo.png");
-                StopButton_texture = Texture_2D::create (0, context, "pause.png");
-                Continue_texture   = Texture_2D::create (0, context, "continuar.png");
+                    BackButton_slice = atlas->get_slice (ID(BackButton));
+                    CopterLogo_slice = atlas->get_slice (ID(CopterLogo));
+                    StopButton_slice = atlas->get_slice (ID(StopButton));
+                    Continue_slice   = atlas->get_slice (ID(Continue));
 
-                if (BackButton_texture && CopterLogo_texture && StopButton_texture && Continue_texture)
-                {
-                    context->add (BackButton_texture);
-                    context->add (CopterLogo_texture);
-                    context->add (StopButton_texture);
-                    context->add (Continue_texture);
-                }else{
-                    state = ERROR;
+                    if (!atlas->get_slice (ID(copter)) || !atlas->get_slice (ID(wall)) || !BackButton_slice || !CopterLogo_slice || !StopButton_slice || !Continue_slice)
+                    {
+                        state = ERROR;
+                    }
                 }
             }
-        }else if (timer.get_elapsed_seconds () > 1.f)   // Si las texturas se han cargado muy rápido
+        }else if (loading_time > 1.f)                   // Si las texturas se han cargado muy rápido
         {                                               // se espera un segundo desde el inicio de
             create_sprites ();                          // la carga antes de pasar al juego para que
-            restart_game   ();                          // el mensaje de carga no aparezca y desaparezca demasiado rápido.
+            simulation.restart ();                      // el mensaje de carga no aparezca y desaparezca demasiado rápido.
             state = RUNNING;
-        }
-    }
-
-    // Creacion de los sprites del techo, el suelo y el jugador
-
-    void Game_Scene::create_sprites ()
-    {
-        Sprite_Handle    top_bar(new Sprite( textures[ID(wall)].get () ));
-        Sprite_Handle bottom_bar(new Sprite( textures[ID(wall)].get () ));
 
-        top_bar->set_anchor   (TOP | LEFT);
-        top_bar->set_position ({ 0, canvas_height });
-        top_bar->set_size({ .0f + canvas_width, .0f + canvas_height / 15});
+            // Si el sistema cerró la aplicación en mitad de una partida, se recupera en pausa:
 
-        bottom_bar->set_anchor   (BOTTOM | LEFT);
-        bottom_bar->set_position ({ 0, 0 });
-        bottom_bar->set_size({ .0f + canvas_width, .0f + canvas_height / 15});
-
-        sprites.push_back (   top_bar);
-        sprites.push_back (bottom_bar);
-
-
-        Sprite_Handle player_handle(new Sprite( textures[ID(copter)].get () ));
-        sprites.push_back ( player_handle);
-
-
-        // Se guardan punteros a los sprites que se van a usar frecuentemente:
-        top_border    =             top_bar.get ();
-        bottom_border =          bottom_bar.get ();
-        player   =  player_handle.get ();
-    }
-
-
-    // Cuando el juego se inicia por primera vez se llama a este método para restablecer la posición y velocidad de los sprites:
-    void Game_Scene::restart_game()
-    {
-        player->set_position ({ canvas_width / 5.f, canvas_height / 2.f });
-        player->set_speed_y  (0.f);
-
-        gameplay = WAITING_TO_START;
-    }
-
-
-
-    void Game_Scene::start_playing ()
-    {
-        player->set_speed_y (-300.f); // Al jugador le afecta la gravedad
-
-        gameplay = PLAYING;
-    }
-
-
-
-    void Game_Scene::run_simulation (float time)
-    {
-        // Se actualiza el estado de los sprites
-        for (auto & sprite : sprites)
-        {
-            sprite->update (time);
-        }
-        if(gameplay == PLAYING){ // Mientras el juego esta en PLAYING, se crean obstaculos aleatorios
-
-            if(rand() % 51 == 0 && timer.get_elapsed_seconds() > .75f){ //Probabilidad random de que aparezca obstaculo y tiempo que tiene que esperar hasta que salga el siguiente
-
-                Sprite_Handle newObstacle(new Sprite( textures[ID(wall)].get () )); //Se crea el nuevo obstaculo
-
-                //Se configuran sus propiedades (Posicion, velocidad,...)
-                newObstacle->set_anchor(CENTER | RIGHT);
-                newObstacle->set_position ({ canvas_width + 75, rand() % (canvas_height - 50) + (50)});
-                newObstacle->set_size({ 75.f, 0.f + rand() % 200 + 100});
-                newObstacle->set_speed_x(-400.f);
-
-                //Se añade el nuevo obstáculo al array
-                obstacles.push_back(newObstacle);
-
-                //Se resetea el timer
-                timer.reset();
-            }
-
-            // Se actualizan los obstáculos y si alguno sale de la pantalla se elimina del array
-            for (auto & sprite : obstacles)
+            if (has_saved_game_to_restore && simulation.restore (saved_game) && simulation.get_gameplay () == Game_Simulation::PLAYING)
             {
-                sprite->update (time);
-
-                if(sprite->get_position_x() <= 0){
-                    obstacles.pop_front();
-                }
+                state = PAUSED;
             }
-        }
-        //Se actualiza al jugador
-        update_user ();
-
-        //Se comprueban las colisiones con los obstáculos
-        check_collisions ();
-    }
-
-
 
-    // Hace que el player vuele o no dependiendo de si el usuario está tocando.
-    // Comprueba si colisiona con el techo y el suelo
-    void Game_Scene::update_user ()
-    {
-        if(gameplay == GAME_OVER){
-            player->set_speed_y(0.0f);
-        } else if(gameplay == PLAYING){
-            if (player->intersects (*top_border))
-            {
-                gameplay = GAME_OVER;
-            }
-            else if (player->intersects (*bottom_border))
-            {
-                gameplay = GAME_OVER;
-            }
-            else if (flying)
-            {
-                player->set_speed_y(350.f);
-            }
-            else
-                player->set_speed_y (-300.f);
+            has_saved_game_to_restore = false;
         }
     }
 
-    // Se detectan las colisiones del jugador con los obstáculos
-    void Game_Scene::check_collisions ()
+    // Creacion de los sprites del techo, el suelo y el jugador. El jugador toma el tamaño de su imagen:
+
+    void Game_Scene::create_sprites ()
     {
-        if(gameplay == PLAYING){
+        const Atlas::Slice * copter_slice = atlas->get_slice (ID(copter));
 
-            for (auto & sprite : obstacles)
-            {
-                if(sprite->intersects(*player)){
-                    gameplay = GAME_OVER;
-                }
-            }
-        }
+        simulation.create_sprites ({ copter_slice->width, copter_slice->height });
     }
 
 
     //Muestra la pantalla de loading
     void Game_Scene::render_loading (Canvas & canvas)
     {
-        Texture_2D * loading_texture = textures[ID(loading)].get ();
-
         if (loading_texture)
         {
             canvas.fill_rectangle
                     (
                             { canvas_width * .5f, canvas_height * .5f },
                             { loading_texture->get_width (), loading_texture->get_height () },
-                            loading_texture
+                            loading_texture.get ()
                     );
         }
     }
@@ -372,39 +400,41 @@ namespace flythecopter
     // Se dibujan todos los sprites que conforman la escena.
     void Game_Scene::render_playfield (Canvas & canvas)
     {
-        if(gameplay == PLAYING || gameplay == WAITING_TO_START){
-            for (auto & sprite : sprites)
-            {
-                sprite->render (canvas);
-            }
-            for (auto & sprite : obstacles)
-            {
-                sprite->render (canvas);
-            }
+        Game_Simulation::Gameplay_State gameplay = simulation.get_gameplay ();
+
+        if (simulation.has_cave ())
+        {
+            render_terrain (canvas, gameplay == Game_Simulation::PLAYING);
+        }
+
+        if(gameplay == Game_Simulation::PLAYING || gameplay == Game_Simulation::WAITING_TO_START){
+            // Solo se mueven mientras se juega, así que solo entonces se adelanta su dibujo:
+            render_sprites (canvas, simulation.get_sprites   (), gameplay == Game_Simulation::PLAYING);
+            render_sprites (canvas, simulation.get_obstacles (), gameplay == Game_Simulation::PLAYING);
         }
 
-        if(gameplay == PLAYING){
+        if(gameplay == Game_Simulation::PLAYING){
             canvas.fill_rectangle
                     (
                             { canvas_width * .9f, canvas_height * .85f },
-                            { (StopButton_texture->get_width ())*.75f, (StopButton_texture->get_height ())*.75f },
-                            StopButton_texture. get ()
+                            { (StopButton_slice->width)*.75f, (StopButton_slice->height)*.75f },
+                            StopButton_slice
                     );
         }
         //Muestra la pantalla de game over
-        else if(gameplay == GAME_OVER){
-            if (BackButton_texture && CopterLogo_texture){
+        else if(gameplay == Game_Simulation::GAME_OVER){
+            if (BackButton_slice && CopterLogo_slice){
                 canvas.fill_rectangle
                         (
                                 { canvas_width * .5f, canvas_height * .6f },
-                                { (CopterLogo_texture->get_width ())*0.9f, (CopterLogo_texture->get_height ())*0.9f },
-                                CopterLogo_texture. get ()
+                                { (CopterLogo_slice->width)*0.9f, (CopterLogo_slice->height)*0.9f },
+                                CopterLogo_slice
                         );
                 canvas.fill_rectangle
                         (
                                 { canvas_width * .5f, canvas_height * .25f },
-                                { (BackButton_texture->get_width ()), (BackButton_texture->get_height ()) },
-                                BackButton_texture. get ()
+                                { (BackButton_slice->width), (BackButton_slice->height) },
+                                BackButton_slice
                         );
             }
         }
@@ -412,14 +442,73 @@ namespace flythecopter
     }
 
 
+    // La cueva entera se dibuja con una sola llamada. Igual que los sprites, se adelanta lo que
+    // habrá avanzado en la fracción de paso transcurrida.
+    void Game_Scene::render_terrain (Canvas & canvas, bool moving)
+    {
+        float advance = moving && get_fixed_step () > 0.f ? interpolation * get_fixed_step () : 0.f;
+
+        unsigned count = simulation.get_terrain ().build_mesh (terrain_mesh.data (), Game_Simulation::scroll_speed * advance);
+
+        canvas.set_color  (.35f, .22f, .12f);
+        canvas.fill_strip (terrain_mesh.data (), count);
+    }
+
+
+    // Los sprites se dibujan en el orden de los arrays del almacén a partir de sus cajas envolventes
+    // ya calculadas, descartando los que quedan fuera de la pantalla. Como los consecutivos suelen
+    // compartir imagen, solo se busca su slice en el atlas cuando el id cambia.
+    // La simulación va por pasos fijos, así que los sprites en movimiento se adelantan lo que habrán
+    // avanzado en la fracción de paso transcurrida para que se desplacen con suavidad a cualquier fps.
+    void Game_Scene::render_sprites (Canvas & canvas, const Sprite_Store & store, bool moving)
+    {
+        float advance = moving && get_fixed_step () > 0.f ? interpolation * get_fixed_step () : 0.f;
+
+        const float   * speeds_x    = store.get_speeds_x    ();
+        const float   * speeds_y    = store.get_speeds_y    ();
+        const float   * lefts       = store.get_lefts       ();
+        const float   * bottoms     = store.get_bottoms     ();
+        const float   * rights      = store.get_rights      ();
+        const float   * tops        = store.get_tops        ();
+        const uint8_t * visibility  = store.get_visibility  ();
+        const Id      * texture_ids = store.get_texture_ids ();
+
+        Id                   current_id = 0;
+        const Atlas::Slice * slice      = nullptr;
+
+        for (unsigned index = 0, count = store.size (); index < count; ++index)
+        {
+            float dx = speeds_x[index] * advance;
+            float dy = speeds_y[index] * advance;
+
+            if (visibility[index] && rights[index] + dx > 0.f && lefts[index] + dx < canvas_width && tops[index] + dy > 0.f && bottoms[index] + dy < canvas_height)
+            {
+                if (!slice || texture_ids[index] != current_id)
+                {
+                    current_id = texture_ids[index];
+                    slice      = atlas->get_slice (current_id);
+                }
+
+                canvas.fill_rectangle
+                (
+                    { lefts [index] + dx, bottoms[index] + dy },
+                    { rights[index] - lefts[index], tops[index] - bottoms[index] },
+                    slice,
+                    BOTTOM | LEFT
+                );
+            }
+        }
+    }
+
+
     //Al pararse el juego se muestra un botón en grande para continuar
     void Game_Scene::render_pause (Canvas & canvas)
     {
         canvas.fill_rectangle
                 (
                         { canvas_width * .5f, canvas_height * .5f },
-                        { (Continue_texture->get_width ()), (Continue_texture->get_height ()) },
-                        Continue_texture. get ()
+                        { (Continue_slice->width), (Continue_slice->height) },
+                        Continue_slice
                 );
     }
 
@@ -11,34 +11,32 @@
 #ifndef GAME_SCENE_HEADER
 #define GAME_SCENE_HEADER
 
-#include <map>
-#include <list>
 #include <memory>
+#include <vector>
 
+#include <basics/Atlas>
 #include <basics/Canvas>
 #include <basics/Id>
 #include <basics/Scene>
 #include <basics/Texture_2D>
-#include <basics/Timer>
 
-#include "Sprite.hpp"
+#include "Autopilot.hpp"
+#include "Game_Simulation.hpp"
+#include "Sprite_Store.hpp"
 
 namespace flythecopter
 {
 
     using basics::Id;
-    using basics::Timer;
     using basics::Canvas;
     using basics::Texture_2D;
+    using basics::Atlas;
 
     class Game_Scene : public basics::Scene
     {
 
         // Estos typedefs pueden ayudar a hacer el código más compacto y claro:
-        typedef std::shared_ptr < Sprite     >     Sprite_Handle;
-        typedef std::list< Sprite_Handle     >     Sprite_List;
         typedef std::shared_ptr< Texture_2D  >     Texture_Handle;
-        typedef std::map< Id, Texture_Handle >     Texture_Map;
         typedef basics::Graphics_Context::Accessor Context;
 
 
@@ -51,52 +49,40 @@ namespace flythecopter
             ERROR
         };
 
-
-        // enum de los posibles estados del juego cuando el estado de la escena es RUNNING.
-        enum Gameplay_State
-        {
-            UNINITIALIZED,
-            WAITING_TO_START,
-            PLAYING,
-            GAME_OVER,
-        };
+        // Id de los toques del piloto automático (los del sistema nunca son negativos):
+        static constexpr int32_t autopilot_touch_id = -1;
 
     private:
 
 
-        // Array de estructuras con la información de las texturas (Id y ruta) que hay que cargar.
-        static struct   Texture_Data { Id id; const char * path; } textures_data[];
-
-
-        // Número de items que hay en el array textures_data.
-        static unsigned textures_count;
-
-    private:
 
         State          state;                               // Estado de la escena.
-        Gameplay_State gameplay;                            // Estado del juego cuando la escena está RUNNING.
         bool           suspended;                           // true cuando la escena está en segundo plano y viceversa.
 
         unsigned       canvas_width;                        // Ancho de la resolución virtual usada para dibujar.
         unsigned       canvas_height;                       // Alto  de la resolución virtual usada para dibujar.
 
-        Texture_Map    textures;                            // Mapa  en el que se guardan shared_ptr a las texturas cargadas.
-        Sprite_List    sprites;                             // Lista en la que se guardan shared_ptr a los sprites creados.
+        Texture_Handle loading_texture;                     // Textura con el mensaje de carga (se carga sola y antes que el resto).
+        std::unique_ptr< Atlas > atlas;                     // Atlas con el resto de imágenes (generado con atlas-builder).
+        Game_Simulation simulation;                         // Lógica del juego (jugador, obstáculos y colisiones) independiente de la plataforma.
 
-        Sprite       * top_border;                          // Puntero al sprite de la lista de sprites que representa el borde superior.
-        Sprite       * bottom_border;                       // Puntero al sprite de la lista de sprites que representa el borde inferior.
-        Sprite       * player;                              // Puntero al sprite de la lista de sprites que representa al jugador.
+        Game_Simulation::Snapshot saved_game;               // Partida guardada por una ejecución anterior (se copia al crear la escena)
+        bool           has_saved_game_to_restore;           // true si saved_game es válida y aún no se ha recuperado
 
-        Sprite_List    obstacles;                           // Conjunto de los sprites de los obstaculos activos en la escena
+        float          loading_time;                        // Tiempo que lleva cargando (según el tiempo que da Director)
+        float          interpolation;                       // Fracción del paso de simulación transcurrida al dibujar (la da Director)
 
-        bool           flying;                              // Representa si el jugador se mueve hacia arriba o hacia abajo
+        bool           autopilot_enabled;                   // true si la partida la juega el piloto automático
+        bool           autopilot_pending;                   // true mientras no llega a handle() el último toque enviado por el piloto automático
+        unsigned       autopilot_games;                     // Partidas que ha perdido y vuelto a empezar el piloto automático
+        std::unique_ptr< Autopilot > autopilot;             // Se crea cuando se conoce el tamaño del jugador
 
-        Timer          timer;                               // Cronómetro usado para medir intervalos de tiempo
+        std::vector< basics::Point2f > terrain_mesh;        // Vértices de la cueva (se rellenan en cada fotograma)
 
-        std::shared_ptr < Texture_2D > CopterLogo_texture;  // Textura del logo del juego
-        std::shared_ptr < Texture_2D > BackButton_texture;  // Textura del boton de volver al menu
-        std::shared_ptr < Texture_2D > StopButton_texture;  // Textura del botón de pausa
-        std::shared_ptr < Texture_2D > Continue_texture;    // Textura del botón continuar
+        const Atlas::Slice * CopterLogo_slice;              // Logo del juego
+        const Atlas::Slice * BackButton_slice;              // Botón de volver al menu
+        const Atlas::Slice * StopButton_slice;              // Botón de pausa
+        const Atlas::Slice * Continue_slice;                // Botón continuar
 
 
     public:
@@ -122,6 +108,31 @@ namespace flythecopter
         bool initialize () override;
 
 
+        /*
+         * Establece la semilla del generador de números aleatorios de la escena. Con la misma semilla
+         * y las mismas pulsaciones los obstáculos aparecen siempre igual.
+         */
+        void set_seed (uint64_t seed)
+        {
+            simulation.set_seed (seed);
+        }
+
+
+        /*
+         * Activa o desactiva el piloto automático para pruebas de larga duración. Juega enviando a
+         * Director los mismos eventos de toque que el usuario y, al perder, vuelve a empezar solo.
+         */
+        void set_autopilot (bool enabled)
+        {
+            autopilot_enabled = enabled;
+        }
+
+        unsigned get_autopilot_games () const
+        {
+            return autopilot_games;
+        }
+
+
         // Este método lo invoca Director automáticamente cuando el juego pasa a segundo plano.
         void suspend () override;
 
@@ -130,6 +141,14 @@ namespace flythecopter
         void resume () override;
 
 
+        // Este método lo invoca Director automáticamente cuando la escena se va a sustituir por otra.
+        void finalize () override;
+
+
+        // Indica si hay una partida guardada de una ejecución anterior que se puede continuar.
+        static bool has_saved_game ();
+
+
         // Este método se invoca automáticamente una vez por fotograma cuando se acumulan eventos dirigidos a la escena.
         void handle (basics::Event & event) override;
 
@@ -141,10 +160,14 @@ namespace flythecopter
         // Este método se invoca automáticamente una vez por fotograma para que la escena dibuje su contenido.
         void render (Context & context) override;
 
+
+        // Director llama a este método con la fracción de paso transcurrida desde la última actualización.
+        void render (Context & context, float alpha) override;
+
     private:
 
 
-        // En este método se cargan las texturas (una cada fotograma para facilitar que la propia carga se pueda pausar cuando la aplicación pasa a segundo plano).
+        // En este método se cargan las texturas: en un fotograma la del mensaje de carga y en el siguiente el atlas con el resto (así la propia carga se puede pausar cuando la aplicación pasa a segundo plano).
         void load_textures ();
 
 
@@ -152,25 +175,14 @@ namespace flythecopter
         void create_sprites ();
 
 
-        // Se llama cada vez que se debe reiniciar el juego. En concreto la primera vez y cada vez que un jugador pierde.
-        void restart_game ();
+        // Decide con el piloto automático qué hacer en el siguiente paso y envía a Director el toque necesario.
+        void drive_autopilot ();
 
 
-        // Cuando se ha reiniciado el juego y el usuario toca la pantalla por primera vez se pone la bola en movimiento en una dirección al azar.
-        void start_playing ();
+        // Lee la partida guardada en el estado de la aplicación. Retorna false si no hay ninguna válida.
+        static bool read_saved_game (Game_Simulation::Snapshot & snapshot);
 
 
-        // Actualiza el estado del juego cuando el estado de la escena es RUNNING.
-        void run_simulation (float time);
-
-
-        // Hace que el player se vuele o no dependiendo de si el usuario está tocando.
-        void update_user ();
-
-
-        // Se detectan las colisiones del jugador con los obstáculos
-        void check_collisions ();
-
         /*
          * Dibuja la textura con el mensaje de carga mientras el estado de la escena es LOADING.
          * La textura con el mensaje se carga la primera para mostrar el mensaje cuanto antes.
@@ -185,6 +197,15 @@ namespace flythecopter
         void render_playfield (Canvas & canvas);
 
 
+        // Dibuja el suelo y el techo de la cueva. Si 'moving' es true se adelantan la fracción de paso indicada por 'interpolation'.
+        void render_terrain (Canvas & canvas, bool moving);
+
+
+        // Dibuja los sprites visibles de un almacén buscando su slice del atlas solo cuando cambia de un sprite al siguiente.
+        // Si 'moving' es true se adelantan según su velocidad la fracción de paso indicada por 'interpolation'.
+        void render_sprites (Canvas & canvas, const Sprite_Store & store, bool moving);
+
+
         // Al pararse el juego se muestra un botón en grande para continuar
         void render_pause (Canvas & canvas);
 
@@ -0,0 +1,345 @@
+/*
+ * GAME SIMULATION
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#include <algorithm>
+
+#include "Game_Simulation.hpp"
+
+using namespace basics;
+
+namespace flythecopter
+{
+
+    constexpr int      Game_Simulation::tick_rate;
+    constexpr unsigned Game_Simulation::obstacle_capacity;
+    constexpr float    Game_Simulation::scroll_speed;
+    constexpr uint32_t Game_Simulation::Snapshot::current_version;
+
+    Game_Simulation::Game_Simulation(const Size2f & world_size)
+    :
+        world_width (world_size.width ),
+        world_height(world_size.height),
+        sprites     (3),
+        obstacles   (obstacle_capacity),
+        terrain     (world_size)
+    {
+        cave         = false;
+        gameplay     = UNINITIALIZED;
+        flying       = false;
+        spawn_time   = 0.f;
+        player_start = { 0.f, 0.f, 0.f, 0.f };
+        step_time    = 0.f;
+        impact_time  = 0.f;
+
+        // El índice de colisiones se dimensiona para el pool de obstáculos y así no reserva memoria al jugar:
+        obstacle_index.reserve (obstacle_capacity);
+    }
+
+    // Creacion de los sprites del techo, el suelo y el jugador
+
+    void Game_Simulation::create_sprites (const Size2f & player_size)
+    {
+        sprites.clear ();
+
+        Size2f border_size{ world_width, float(unsigned(world_height) / 15) };
+
+        top_border    = sprites.create (ID(wall), border_size);
+        bottom_border = sprites.create (ID(wall), border_size);
+
+        sprites.set_anchor   (top_border, TOP | LEFT);
+        sprites.set_position (top_border, { 0, world_height });
+
+        sprites.set_anchor   (bottom_border, BOTTOM | LEFT);
+        sprites.set_position (bottom_border, { 0, 0 });
+
+        player = sprites.create (ID(copter), player_size);
+    }
+
+    // Cuando el juego se inicia se llama a este método para restablecer la posición y velocidad de los sprites:
+
+    void Game_Simulation::restart ()
+    {
+        sprites.set_position (player, { world_width / 5.f, world_height / 2.f });
+        sprites.set_speed_y  (player, 0.f);
+
+        obstacles.clear ();
+        terrain  .reset ();
+
+        // En la cueva el suelo y el techo son los del terreno:
+
+        if (cave) { sprites.hide (top_border); sprites.hide (bottom_border); }
+        else      { sprites.show (top_border); sprites.show (bottom_border); }
+
+        flying      = false;
+        spawn_time  = 0.f;
+        impact_time = 0.f;
+        gameplay    = WAITING_TO_START;
+    }
+
+    void Game_Simulation::start_playing ()
+    {
+        sprites.set_speed_y (player, -300.f); // Al jugador le afecta la gravedad
+
+        gameplay = PLAYING;
+    }
+
+    void Game_Simulation::move_sprites (float time)
+    {
+        // Se guarda de dónde parte el jugador para comprobar después las colisiones en todo su recorrido:
+
+        player_start = sprites.get_bounds (player);
+        step_time    = time;
+
+        sprites.update (time);
+    }
+
+    void Game_Simulation::scroll_terrain (float time)
+    {
+        if (cave) terrain.advance (scroll_speed * time);
+    }
+
+    void Game_Simulation::spawn_obstacles (float time)
+    {
+        spawn_time += time;
+
+        if(random.next (51) == 0 && spawn_time > .75f){ //Probabilidad random de que aparezca obstaculo y tiempo (simulado) que tiene que esperar hasta que salga el siguiente
+
+            float y      = random.next (unsigned(world_height) - 50) + (50);
+            float height = random.next (200) + 100;
+            bool  fits   = true;
+
+            // En la cueva el obstáculo se coloca dentro de la abertura, más corto si hace falta para que
+            // quede al menos un hueco de 150 px por el que pueda pasar el jugador:
+            if (cave)
+            {
+                float floor_a, ceiling_a, floor_b, ceiling_b;
+
+                terrain.get_gap (world_width,        floor_a, ceiling_a);
+                terrain.get_gap (world_width + 75.f, floor_b, ceiling_b);
+
+                float floor   = std::max (floor_a,   floor_b  );
+                float ceiling = std::min (ceiling_a, ceiling_b);
+
+                height = std::min (height, ceiling - floor - 150.f);
+                fits   = height >= 40.f;
+                y      = floor + height / 2.f + (y - 50.f) / (world_height - 50.f) * (ceiling - floor - height);
+            }
+
+            if (fits)
+            {
+                Sprite_Handle obstacle = obstacles.create (ID(wall), { 75.f, height }); //Se recicla un hueco del pool para el nuevo obstaculo
+
+                //Se configuran sus propiedades (Posicion, velocidad,...). Si el pool está lleno no aparece
+                if (obstacles.is_valid (obstacle))
+                {
+                    obstacles.set_anchor   (obstacle, CENTER | RIGHT);
+                    obstacles.set_position (obstacle, { world_width + 75.f, y });
+                    obstacles.set_speed_x  (obstacle, -scroll_speed);
+                }
+            }
+
+            //Se reinicia la cuenta hasta el siguiente
+            spawn_time = 0.f;
+        }
+    }
+
+    void Game_Simulation::move_obstacles (float time)
+    {
+        obstacles.update (time);
+
+        // Los que han salido de la pantalla devuelven su hueco al pool. Se recorre hacia atrás
+        // porque al eliminar uno su hueco lo ocupa el último:
+        const float * positions_x = obstacles.get_positions_x ();
+
+        for (unsigned index = obstacles.size (); index-- > 0; )
+        {
+            if (positions_x[index] <= 0)
+            {
+                obstacles.destroy_at (index);
+            }
+        }
+    }
+
+    // Hace que el player vuele o no dependiendo de si el usuario está tocando.
+    void Game_Simulation::update_user ()
+    {
+        if(gameplay == GAME_OVER){
+            sprites.set_speed_y (player, 0.0f);
+        } else if(gameplay == PLAYING){
+            if (flying)
+            {
+                sprites.set_speed_y (player, 350.f);
+            }
+            else
+                sprites.set_speed_y (player, -300.f);
+        }
+    }
+
+    // Se detectan las colisiones del jugador con el techo, el suelo y los obstáculos. No basta con mirar
+    // si las cajas se solapan al final del paso: con pasos largos (a menos pasos por segundo o tras
+    // una pausa) el jugador podría atravesar un obstáculo de 75 px sin llegar a solaparse con él, así
+    // que se comprueba todo el recorrido y se toma el primer choque.
+    void Game_Simulation::check_collisions ()
+    {
+        if(gameplay == PLAYING){
+
+            Sprite_Store::Bounds player_end = sprites.get_bounds (player);
+
+            float dx = player_end.left   - player_start.left;
+            float dy = player_end.bottom - player_start.bottom;
+
+            float impact = 1.f, time;             // Un choque siempre ocurre antes del final del paso (impact < 1)
+
+            // Los bordes rectos no se mueven:
+
+            if (!cave)
+            {
+                if (Sprite_Store::sweep (player_start, dx, dy, sprites.get_bounds (top_border   ), time) && time < impact) impact = time;
+                if (Sprite_Store::sweep (player_start, dx, dy, sprites.get_bounds (bottom_border), time) && time < impact) impact = time;
+            }
+
+            // La cueva se comprueba al final del paso (el suelo y el techo son macizos, así que no se
+            // pueden atravesar). Si hay choque, el momento en el que se produjo se busca por bisección
+            // colocando al jugador y la cueva donde estaban en cada instante:
+            float terrain_shift = scroll_speed * step_time;
+
+            if (cave && terrain.collides (player_end))
+            {
+                float before = 0.f, after = 1.f;
+
+                if (!terrain.collides (player_start, terrain_shift))
+                {
+                    for (unsigned iteration = 0; iteration < 12; ++iteration)
+                    {
+                        float middle = (before + after) / 2.f;
+
+                        Sprite_Store::Bounds box
+                        {
+                            player_start.left   + dx * middle, player_start.bottom + dy * middle,
+                            player_start.right  + dx * middle, player_start.top    + dy * middle
+                        };
+
+                        if (terrain.collides (box, terrain_shift * (1.f - middle))) after = middle; else before = middle;
+                    }
+                }
+                else
+                    after = 0.f;
+
+                if (after < impact) impact = after;
+            }
+
+            // El índice descarta los obstáculos cuyo intervalo en X no llega al recorrido del jugador y
+            // solo con el resto se comprueba el choque exacto:
+            obstacle_index.update (obstacles);
+
+            unsigned obstacle = obstacle_index.find_first_impact (obstacles, player_start, dx, dy, step_time, time);
+
+            if (obstacle != Sprite_Store::npos && time < impact) impact = time;
+
+            if (impact < 1.f)
+            {
+                // El juego se detiene en el momento del choque: el jugador vuelve al punto de su
+                // recorrido en el que chocó y los obstáculos retroceden lo que avanzaron después:
+
+                Point2f position = sprites.get_position (player);
+
+                position[0] += player_start.left   + dx * impact - player_end.left;
+                position[1] += player_start.bottom + dy * impact - player_end.bottom;
+
+                sprites.set_position (player, position);
+                sprites.set_speed_y  (player, 0.f);
+
+                obstacles.update (-step_time * (1.f - impact));
+
+                // La cueva conserva por la izquierda las columnas necesarias para volver atrás en
+                // pasos de hasta 1,28 s (ver Cave_Terrain::history):
+
+                if (cave) terrain.advance (-terrain_shift * (1.f - impact));
+
+                impact_time = impact;
+                gameplay    = GAME_OVER;
+            }
+        }
+    }
+
+    void Game_Simulation::save (Snapshot & snapshot) const
+    {
+        snapshot.version        = Snapshot::current_version;
+        snapshot.gameplay       = int32_t(gameplay);
+        snapshot.flying         = flying;
+        snapshot.spawn_time     = spawn_time;
+        snapshot.random         = random.get_state ();
+
+        snapshot.player_x       = sprites.get_position_x (player);
+        snapshot.player_y       = sprites.get_position_y (player);
+        snapshot.player_speed_y = sprites.get_speed_y    (player);
+
+        // Todos los obstáculos se anclan igual (CENTER | RIGHT), por lo que basta con su posición, tamaño y velocidad:
+
+        const float * positions_x = obstacles.get_positions_x ();
+        const float * positions_y = obstacles.get_positions_y ();
+        const float * widths      = obstacles.get_widths      ();
+        const float * heights     = obstacles.get_heights     ();
+        const float * speeds_x    = obstacles.get_speeds_x    ();
+
+        snapshot.obstacle_count = obstacles.size ();
+
+        for (unsigned index = 0; index < snapshot.obstacle_count; ++index)
+        {
+            snapshot.obstacles[index] = { positions_x[index], positions_y[index], widths[index], heights[index], speeds_x[index] };
+        }
+
+        snapshot.cave = cave;
+
+        terrain.save (snapshot.terrain);
+    }
+
+    bool Game_Simulation::restore (const Snapshot & snapshot)
+    {
+        if (snapshot.version != Snapshot::current_version || snapshot.obstacle_count > obstacle_capacity ||
+            snapshot.gameplay < UNINITIALIZED || snapshot.gameplay > GAME_OVER || !sprites.is_valid (player) ||
+           !terrain.restore (snapshot.terrain))
+        {
+            return false;
+        }
+
+        cave = snapshot.cave != 0;
+
+        if (cave) { sprites.hide (top_border); sprites.hide (bottom_border); }
+        else      { sprites.show (top_border); sprites.show (bottom_border); }
+
+        gameplay   = Gameplay_State(snapshot.gameplay);
+        flying     = snapshot.flying != 0;
+        spawn_time = snapshot.spawn_time;
+
+        random.set_state (snapshot.random);
+
+        sprites.set_position (player, { snapshot.player_x, snapshot.player_y });
+        sprites.set_speed_y  (player, snapshot.player_speed_y);
+
+        // Los obstáculos se vuelven a crear en el mismo orden. El pool tiene capacidad para todos,
+        // así que no se reserva memoria:
+
+        obstacles.clear ();
+
+        for (unsigned index = 0; index < snapshot.obstacle_count; ++index)
+        {
+            const Snapshot::Obstacle & saved    = snapshot.obstacles[index];
+            Sprite_Handle              obstacle = obstacles.create (ID(wall), { saved.width, saved.height });
+
+            obstacles.set_anchor   (obstacle, CENTER | RIGHT);
+            obstacles.set_position (obstacle, { saved.x, saved.y });
+            obstacles.set_speed_x  (obstacle, saved.speed_x);
+        }
+
+        return true;
+    }
+
+}
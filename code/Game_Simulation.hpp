@@ -0,0 +1,236 @@
+/*
+ * GAME SIMULATION
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#ifndef GAME_SIMULATION_HEADER
+#define GAME_SIMULATION_HEADER
+
+    #include <cstdint>
+    #include <type_traits>
+    #include <basics/Random>
+    #include <basics/Size>
+
+    #include "Cave_Terrain.hpp"
+    #include "Collision_Index.hpp"
+    #include "Sprite_Store.hpp"
+
+    namespace flythecopter
+    {
+
+        using basics::Random;
+
+        /*
+         * Lógica del juego separada de Game_Scene: jugador, bordes, obstáculos, aparición aleatoria
+         * y colisiones. No usa Canvas, texturas ni relojes del sistema (el tiempo lo recibe en cada
+         * paso), por lo que se puede ejecutar sin dispositivo ni contexto gráfico, por ejemplo en
+         * las herramientas de escritorio de tools/.
+         */
+        class Game_Simulation
+        {
+        public:
+
+            typedef Sprite_Store::Handle Sprite_Handle;
+
+            // Estados del juego (los que antes tenía Game_Scene cuando la escena estaba RUNNING).
+            enum Gameplay_State
+            {
+                UNINITIALIZED,
+                WAITING_TO_START,
+                PLAYING,
+                GAME_OVER,
+            };
+
+            // Frecuencia fija (en pasos por segundo) con la que se debe avanzar la simulación.
+            static constexpr int      tick_rate         = 60;
+
+            // Número máximo de obstáculos activos a la vez. Aparecen como mucho cada 0,75 s y tardan unos
+            // 3,4 s en cruzar la pantalla, por lo que nunca llega a haber más de 5.
+            static constexpr unsigned obstacle_capacity = 16;
+
+            // Velocidad (en px/s) a la que avanzan hacia la izquierda los obstáculos y la cueva.
+            static constexpr float    scroll_speed      = 400.f;
+
+            /*
+             * Copia completa del estado variable de la simulación. Es un tipo POD de tamaño fijo (algo
+             * menos de 1,5 KB, casi todo el terreno de la cueva), así que se puede copiar con memcpy,
+             * guardar en disco o en el estado de la actividad de Android, y restaurar en microsegundos
+             * para volver atrás o explorar jugadas.
+             * No incluye lo que no cambia al jugar (tamaño de la zona de juego, bordes y tamaño del
+             * jugador), que se establece con el constructor y create_sprites().
+             */
+            struct Snapshot
+            {
+                static constexpr uint32_t current_version = 2;
+
+                struct Obstacle
+                {
+                    float x, y;
+                    float width, height;
+                    float speed_x;
+                };
+
+                uint32_t       version;
+                int32_t        gameplay;
+                uint8_t        flying;
+                float          spawn_time;
+                Random::State  random;
+
+                float          player_x;
+                float          player_y;
+                float          player_speed_y;
+
+                uint32_t       obstacle_count;
+                Obstacle       obstacles[obstacle_capacity];
+
+                uint8_t        cave;
+                Cave_Terrain::State terrain;
+            };
+
+        private:
+
+            float           world_width;                    // Ancho de la zona de juego (en coordenadas virtuales).
+            float           world_height;                   // Alto  de la zona de juego (en coordenadas virtuales).
+
+            Gameplay_State  gameplay;                       // Estado del juego.
+
+            Sprite_Store    sprites;                        // Almacén con los sprites fijos (bordes y jugador).
+            Sprite_Handle   top_border;                     // Handle del sprite que representa el borde superior.
+            Sprite_Handle   bottom_border;                  // Handle del sprite que representa el borde inferior.
+            Sprite_Handle   player;                         // Handle del sprite que representa al jugador.
+
+            Sprite_Store    obstacles;                      // Pool de capacidad fija con los obstaculos activos (no reserva memoria mientras se juega)
+            Collision_Index obstacle_index;                 // Índice de barrido en X de los obstáculos para detectar colisiones con el jugador
+
+            Cave_Terrain    terrain;                        // Suelo y techo de la cueva
+            bool            cave;                           // true si se juega en la cueva (en lugar de entre los bordes rectos)
+
+            Random          random;                         // Generador de números aleatorios para la aparición de obstáculos
+            bool            flying;                         // Representa si el jugador se mueve hacia arriba o hacia abajo
+            float           spawn_time;                     // Tiempo simulado desde que apareció el último obstáculo
+
+            Sprite_Store::Bounds player_start;              // Caja del jugador al principio del paso en curso
+            float                step_time;                 // Duración del paso en curso
+            float                impact_time;               // Fracción del paso en la que el jugador chocó (en GAME_OVER)
+
+        public:
+
+            /*
+             * Prepara una simulación vacía. Hay que llamar a create_sprites() antes de usarla.
+             * @param world_size Tamaño de la zona de juego (el de la resolución virtual de la escena).
+             */
+            Game_Simulation(const basics::Size2f & world_size);
+
+            /*
+             * Crea los bordes y el jugador.
+             * @param player_size Tamaño del jugador (normalmente el de su textura).
+             */
+            void create_sprites (const basics::Size2f & player_size);
+
+            // Coloca al jugador en su posición inicial, elimina los obstáculos y espera a que se empiece a jugar.
+            void restart ();
+
+            // Pone al jugador en movimiento. Se llama cuando el usuario toca la pantalla por primera vez.
+            void start_playing ();
+
+            // Indica si el usuario está tocando la pantalla (el jugador sube) o no (el jugador cae).
+            void set_flying (bool new_flying)
+            {
+                flying = new_flying;
+            }
+
+            /*
+             * Establece la semilla del generador de números aleatorios. Con la misma semilla y las
+             * mismas pulsaciones los obstáculos aparecen siempre igual.
+             */
+            void set_seed (uint64_t seed)
+            {
+                random .set_seed (seed);
+                terrain.set_seed (seed);
+            }
+
+            /*
+             * Hace que se juegue en una cueva con el suelo y el techo irregulares en lugar de entre los
+             * bordes rectos (que se ocultan). Tiene efecto al llamar a restart().
+             */
+            void set_cave (bool enabled)
+            {
+                cave = enabled;
+            }
+
+        public:
+
+            /*
+             * Avanza la simulación. Equivale a llamar a las fases siguientes en orden.
+             * @param time Tiempo que se debe avanzar (normalmente 1 / tick_rate).
+             */
+            void step (float time)
+            {
+                move_sprites (time);
+
+                if (gameplay == PLAYING)
+                {
+                    scroll_terrain  (time);
+                    spawn_obstacles (time);
+                    move_obstacles  (time);
+                }
+
+                update_user      ();
+                check_collisions ();
+            }
+
+            // Fases de un paso (son públicas para poder medirlas por separado):
+
+            void move_sprites     (float time);         // Mueve los bordes y el jugador.
+            void scroll_terrain   (float time);         // Desplaza la cueva (y genera la parte que entra por la derecha).
+            void spawn_obstacles  (float time);         // Hace aparecer obstáculos al azar.
+            void move_obstacles   (float time);         // Mueve los obstáculos y recicla los que salen de la pantalla.
+            void update_user      ();                   // Hace que el jugador suba o caiga según se toque la pantalla.
+            void check_collisions ();                   // Comprueba si el jugador ha chocado durante el paso con el techo, el suelo o un obstáculo.
+
+        public:
+
+            // Copia el estado actual de la simulación en 'snapshot'.
+            void save (Snapshot & snapshot) const;
+
+            /*
+             * Restablece un estado guardado con save(). La simulación debe tener ya creados sus sprites.
+             * @return false (sin cambiar nada) si la copia es de una versión distinta o no es válida.
+             */
+            bool restore (const Snapshot & snapshot);
+
+        public:
+
+            bool                 has_cave      () const { return cave;      }
+            const Cave_Terrain & get_terrain   () const { return terrain;   }
+            Gameplay_State       get_gameplay  () const { return gameplay;  }
+            bool                 is_flying     () const { return flying;    }
+            const Sprite_Store & get_sprites   () const { return sprites;   }
+            const Sprite_Store & get_obstacles () const { return obstacles; }
+
+            Sprite_Store::Bounds get_player_bounds () const
+            {
+                return sprites.get_bounds (player);
+            }
+
+            /*
+             * Tras chocar (en GAME_OVER), fracción del último paso (entre 0 y 1) en la que se produjo el
+             * choque. El jugador se queda en la posición en la que tocó aquello con lo que chocó.
+             */
+            float get_impact_time () const
+            {
+                return impact_time;
+            }
+
+        };
+
+        static_assert(std::is_trivially_copyable< Game_Simulation::Snapshot >::value, "Game_Simulation::Snapshot must be copyable with memcpy");
+
+    }
+
+#endif
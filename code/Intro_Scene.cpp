@@ -28,7 +28,7 @@ namespace flythecopter
 
         }else{
 
-            timer.reset ();
+            elapsed = 0.f;
 
             logoNum = 0;
             opacity = 0.f;
@@ -42,6 +42,10 @@ namespace flythecopter
     // Este método se invoca automáticamente una vez por fotograma para que la escena actualize su estado.
     void Intro_Scene::update (float time)
     {
+        // Se usa el tiempo que da Director en lugar de un reloj para que la introducción dure lo mismo
+        // cuando se reproduce una grabación o se ejecuta con un reloj virtual:
+        if (!suspended) elapsed += time;
+
         if (!suspended) switch (state)
             {
                 case LOADING:    update_loading    (); break;
@@ -121,7 +125,7 @@ namespace flythecopter
                 context->add (EsneLogo_texture);
                 context->add (CopterLogo_texture);
 
-                timer.reset ();
+                elapsed = 0.f;
 
                 logoNum = 0;
                 opacity = 0.f;
@@ -138,15 +142,13 @@ namespace flythecopter
     // Amuento progresivo de la opacidad del canvas
     void Intro_Scene::update_fading_in ()
     {
-        float elapsed_seconds = timer.get_elapsed_seconds ();
-
-        if (elapsed_seconds < 1.f)
+        if (elapsed < 1.f)
         {
-            opacity = elapsed_seconds;      // Se aumenta la opacidad del logo a medida que pasa el tiempo
+            opacity = elapsed;      // Se aumenta la opacidad del logo a medida que pasa el tiempo
 
         }else{
 
-            timer.reset ();
+            elapsed = 0.f;
 
             opacity = 1.f;
             state   = WAITING;
@@ -157,9 +159,9 @@ namespace flythecopter
     // Se esperan dos segundos mostrando el logo
     void Intro_Scene::update_waiting ()
     {
-        if (timer.get_elapsed_seconds () > 2.f)
+        if (elapsed > 2.f)
         {
-            timer.reset ();
+            elapsed = 0.f;
 
             state = FADING_OUT;
         }
@@ -171,11 +173,9 @@ namespace flythecopter
     // Disminución progresiva de la opacidad del canvas
     void Intro_Scene::update_fading_out ()
     {
-        float elapsed_seconds = timer.get_elapsed_seconds ();
-
-        if (elapsed_seconds < .5f)
+        if (elapsed < .5f)
         {
-            opacity = 1.f - elapsed_seconds * 2.f;      // Se reduce la opacidad de 1 a 0 en medio segundo
+            opacity = 1.f - elapsed * 2.f;      // Se reduce la opacidad de 1 a 0 en medio segundo
 
         }else{
 
@@ -191,7 +191,7 @@ namespace flythecopter
                 //Cuando el fadeout del primer logo se ha completado, se cambia el estado y se vuelve al fading in para el segundo logo
                 logoNum = 1;
                 opacity = 0.f;
-                timer.reset ();
+                elapsed = 0.f;
                 state = FADING_IN;
             }
         }
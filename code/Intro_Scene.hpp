@@ -15,12 +15,10 @@
 #include <basics/Canvas>
 #include <basics/Scene>
 #include <basics/Texture_2D>
-#include <basics/Timer>
 
 namespace flythecopter
 {
 
-    using basics::Timer;
     using basics::Canvas;
     using basics::Texture_2D;
     using basics::Graphics_Context;
@@ -49,7 +47,7 @@ namespace flythecopter
         unsigned canvas_width;                              //Ancho de la resolución virtual usada para dibujar.
         unsigned canvas_height;                             //Alto  de la resolución virtual usada para dibujar.
 
-        Timer    timer;                                     //Cronómetro usado para medir intervalos de tiempo.
+        float    elapsed;                                   //Tiempo transcurrido en el estado actual (según el tiempo que da Director).
 
         float    opacity;                                   //Opacidad del canvas.
 
@@ -68,6 +66,10 @@ namespace flythecopter
             canvas_width  = 1280;
             canvas_height =  720;
             logoNum       = 0;
+            elapsed       = 0.f;
+
+            // Los logos cambian despacio, así que no hace falta dibujar a más de 30 fps:
+            set_frame_rate (30);
         }
 
         /*
@@ -10,6 +10,8 @@
 
 #include "Menu_Scene.hpp"
 #include "Game_Scene.hpp"
+#include "Stress_Scene.hpp"
+#include <basics/Application>
 #include <basics/Canvas>
 #include <basics/Director>
 #include <basics/Transformation>
@@ -28,6 +30,11 @@ namespace flythecopter
         canvas_width  = 1280;
         canvas_height =  720;
         ayuda = false;
+
+        CopterLogo_slice = PlayButton_slice = Ayuda_slice = Texto_slice = nullptr;
+
+        // El menú es estático, así que no hace falta dibujar a más de 30 fps:
+        set_frame_rate (30);
     }
 
     // Aquí se inicializan los atributos que deben restablecerse cada vez que se inicia la escena.
@@ -86,11 +93,24 @@ namespace flythecopter
 
                     if (option_at (touch_location) == PLAY && !ayuda)
                     {
-                        director.run_scene (shared_ptr< Scene >(new Game_Scene));
+                        // Con "-e autopilot 1" al lanzar la aplicación juega el piloto automático:
+
+                        Game_Scene * game_scene = new Game_Scene;
+
+                        game_scene->set_autopilot (application.get_launch_option ("autopilot") == "1");
+
+                        director.run_scene (shared_ptr< Scene >(game_scene));
                     }
                     else if (option_at (touch_location) == AYUDA){
                         ayuda = true;
                     }
+                    #ifndef NDEBUG
+                    // En las versiones de depuración, tocar el logo abre la prueba de carga (para medir
+                    // el rendimiento en el dispositivo). En las de publicación no se puede abrir por error:
+                    else if (!ayuda && logo_at (touch_location)){
+                        director.run_scene (shared_ptr< Scene >(new Stress_Scene));
+                    }
+                    #endif
 
                     break;
                 }
@@ -109,19 +129,18 @@ namespace flythecopter
 
             if (context)
             {
-                // Asigna una imagen a las texturas
-                PlayButton_texture = Texture_2D::create (0, context, "PlayButton.png");
-                CopterLogo_texture = Texture_2D::create (0, context, "CopterLogo.png");
-                Ayuda_texture = Texture_2D::create (0, context, "ayuda.png");
-                Texto_texture = Texture_2D::create (0, context, "texto.png");
-
-                // En caso de que las texturas esten cargadas, la escena entra en estado READY
-                if (PlayButton_texture && CopterLogo_texture && Ayuda_texture && Texto_texture)
+                // Todas las imágenes del menú están en un mismo atlas para que se dibujen sin cambiar
+                // de textura (se genera con el target atlases de project/linux):
+                atlas.reset (new Atlas("atlases/menu-scene.atlas", context));
+
+                PlayButton_slice = atlas->get_slice (ID(PlayButton));
+                CopterLogo_slice = atlas->get_slice (ID(CopterLogo));
+                Ayuda_slice      = atlas->get_slice (ID(ayuda));
+                Texto_slice      = atlas->get_slice (ID(texto));
+
+                // En caso de que las imágenes esten cargadas, la escena entra en estado READY
+                if (PlayButton_slice && CopterLogo_slice && Ayuda_slice && Texto_slice)
                 {
-                    context->add (PlayButton_texture);
-                    context->add (CopterLogo_texture);
-                    context->add (Ayuda_texture);
-                    context->add (Texto_texture);
                     state = READY;
 
                 }else{
@@ -154,30 +173,33 @@ namespace flythecopter
             // Si el canvas se ha podido obtener o crear, se puede dibujar con él:
             if (canvas)
             {
+                // Como todas las imágenes están en el mismo atlas, el menú entero se dibuja en un lote:
+                canvas->set_batching (true);
+
                 canvas->clear ();
 
                 if (state == READY)
                 {
                     if(!ayuda){
                         // Dibuja el menu
-                        if (PlayButton_texture && CopterLogo_texture){
+                        if (PlayButton_slice && CopterLogo_slice){
                             canvas->fill_rectangle
                                     (
                                             {canvas_width * .5f, canvas_height * .7f},
-                                            {(CopterLogo_texture->get_width ())*1.f, (CopterLogo_texture->get_height ())*1.f },
-                                            CopterLogo_texture. get ()
+                                            {(CopterLogo_slice->width)*1.f, (CopterLogo_slice->height)*1.f },
+                                            CopterLogo_slice
                                     );
                             canvas->fill_rectangle
                                     (
                                             {options[0].position[0], options[0].position[1]},
-                                            {(PlayButton_texture->get_width ()), (PlayButton_texture->get_height ()) },
-                                            PlayButton_texture. get ()
+                                            {(PlayButton_slice->width), (PlayButton_slice->height) },
+                                            PlayButton_slice
                                     );
                             canvas->fill_rectangle
                                     (
                                             {options[1].position[0], options[1].position[1]},
-                                            {(Ayuda_texture->get_width ()), (Ayuda_texture->get_height ()) },
-                                            Ayuda_texture. get ()
+                                            {(Ayuda_slice->width), (Ayuda_slice->height) },
+                                            Ayuda_slice
                                     );
                         }
                     }
@@ -186,8 +208,8 @@ namespace flythecopter
                         canvas->fill_rectangle
                                 (
                                         { canvas_width * .5f, canvas_height * .5f },
-                                        { (Texto_texture->get_width ()), (Texto_texture->get_height ()) },
-                                        Texto_texture. get ()
+                                        { (Texto_slice->width), (Texto_slice->height) },
+                                        Texto_slice
                                 );
                     }
 
@@ -201,7 +223,7 @@ namespace flythecopter
     {
         // Se calcula la altura total del menú:
         float menu_height = 0;
-        for (auto & option : options) menu_height += (PlayButton_texture->get_height ())*2;
+        for (auto & option : options) menu_height += (PlayButton_slice->height)*2;
 
 
         // Se calcula la posición del borde superior del menú en su conjunto de modo que
@@ -214,7 +236,7 @@ namespace flythecopter
         {
             options[index].position = Point2f{ canvas_width / 2.f, option_top };
 
-            option_top -= (PlayButton_texture->get_height ());
+            option_top -= (PlayButton_slice->height);
         }
 
 
@@ -223,6 +245,17 @@ namespace flythecopter
     }
 
 
+    // Indica si el punto está sobre el logo (que se dibuja centrado en (.5, .7) de la pantalla).
+    bool Menu_Scene::logo_at (const Point2f & point)
+    {
+        return
+            point[0] > canvas_width  * .5f - CopterLogo_slice->width  / 2.f &&
+            point[0] < canvas_width  * .5f + CopterLogo_slice->width  / 2.f &&
+            point[1] > canvas_height * .7f - CopterLogo_slice->height / 2.f &&
+            point[1] < canvas_height * .7f + CopterLogo_slice->height / 2.f;
+    }
+
+
     // Devuelve el índice de la opción que se encuentra bajo el punto indicado.
     int Menu_Scene::option_at (const Point2f & point)
     {
@@ -232,10 +265,10 @@ namespace flythecopter
 
             if
             (
-                point[0] > option.position[0] - PlayButton_texture->get_width()  &&
-                point[0] < option.position[0] + PlayButton_texture->get_width()  &&
-                point[1] > option.position[1] - PlayButton_texture->get_height() &&
-                point[1] < option.position[1] + PlayButton_texture->get_height()
+                point[0] > option.position[0] - PlayButton_slice->width  &&
+                point[0] < option.position[0] + PlayButton_slice->width  &&
+                point[1] > option.position[1] - PlayButton_slice->height &&
+                point[1] < option.position[1] + PlayButton_slice->height
             )
             {
                 return index;
@@ -12,7 +12,7 @@
 #define MENU_SCENE_HEADER
 
     #include <memory>
-    #include <basics/Texture_2D>
+    #include <basics/Atlas>
     #include <basics/Canvas>
     #include <basics/Point>
     #include <basics/Scene>
@@ -25,7 +25,7 @@
         using basics::Canvas;
         using basics::Point2f;
         using basics::Size2f;
-        using basics::Texture_2D;
+        using basics::Atlas;
         using basics::Graphics_Context;
 
         class Menu_Scene : public basics::Scene
@@ -68,10 +68,12 @@
 
             Option   options[number_of_options];                // Datos de las opciones del menú
 
-            std::shared_ptr < Texture_2D > CopterLogo_texture;  // Textura del logo del juego
-            std::shared_ptr < Texture_2D > PlayButton_texture;  // Textura del botón de play
-            std::shared_ptr < Texture_2D > Ayuda_texture;       // Textura del botón de ayuda
-            std::shared_ptr < Texture_2D > Texto_texture;       // Textura de las instrucciones
+            std::unique_ptr< Atlas > atlas;                     // Atlas con todas las imágenes del menú (generado con atlas-builder)
+
+            const Atlas::Slice * CopterLogo_slice;              // Logo del juego
+            const Atlas::Slice * PlayButton_slice;              // Botón de play
+            const Atlas::Slice * Ayuda_slice;                   // Botón de ayuda
+            const Atlas::Slice * Texto_slice;                   // Instrucciones
 
             bool ayuda;                                         // Variable para activar y desactivar el texto de ayuda
 
@@ -134,6 +136,9 @@
              */
             int option_at (const Point2f & point);
 
+            // Indica si el punto está sobre el logo del juego.
+            bool logo_at (const Point2f & point);
+
         };
 
     }
@@ -0,0 +1,164 @@
+/*
+ * OBSTACLE STRESS
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#include <cstdio>
+
+#include "Obstacle_Stress.hpp"
+
+using namespace basics;
+
+namespace flythecopter
+{
+
+    const Obstacle_Stress::Settings Obstacle_Stress::default_settings =
+    {
+        1000.f,                                     // spawn_rate
+        32768,                                      // capacity
+        8.f,   64.f,                                // min_size, max_size
+        200.f, 1200.f,                              // min_speed, max_speed
+        true                                        // find_pairs
+    };
+
+    Obstacle_Stress::Obstacle_Stress(const Size2f & world_size, const Settings & settings, uint64_t seed)
+    :
+        world_width (world_size.width ),
+        world_height(world_size.height),
+        settings    (settings),
+        obstacles   (settings.capacity),
+        random      (seed)
+    {
+        // El jugador es del tamaño del de Game_Scene y está en el mismo sitio:
+        player = { world_width / 5.f - 83.f, world_height / 2.f - 33.f, world_width / 5.f + 83.f, world_height / 2.f + 33.f };
+
+        obstacle_index.reserve (settings.capacity);
+
+        clear ();
+    }
+
+    void Obstacle_Stress::clear ()
+    {
+        obstacles.clear ();
+
+        pending  = 0.f;
+        counters = Counters{};
+    }
+
+    void Obstacle_Stress::step (float time)
+    {
+        counters = Counters{};
+
+        // Aparecen los obstáculos que corresponden al tiempo transcurrido. Se colocan igual que los del
+        // juego, justo a la derecha de la pantalla:
+
+        pending += settings.spawn_rate * time;
+
+        for ( ; pending >= 1.f; pending -= 1.f)
+        {
+            float width  = random.between (settings.min_size,  settings.max_size );
+            float height = random.between (settings.min_size,  settings.max_size );
+            float speed  = random.between (settings.min_speed, settings.max_speed);
+            float y      = random.between (0.f, world_height);
+
+            Sprite_Store::Handle obstacle = obstacles.create (ID(wall), { width, height });
+
+            if (obstacles.is_valid (obstacle))
+            {
+                obstacles.set_anchor   (obstacle, CENTER | RIGHT);
+                obstacles.set_position (obstacle, { world_width + width, y });
+                obstacles.set_speed_x  (obstacle, -speed);
+
+                counters.spawned++;
+            }
+            else
+                counters.dropped++;
+        }
+
+        // Se mueven y se eliminan los que han salido por la izquierda:
+
+        obstacles.update (time);
+
+        const float * rights = obstacles.get_rights ();
+
+        for (unsigned index = obstacles.size (); index-- > 0; )
+        {
+            if (rights[index] <= 0.f)
+            {
+                obstacles.destroy_at (index);
+            }
+        }
+
+        // Colisiones:
+
+        obstacle_index.update          (obstacles);
+        obstacle_index.reset_box_tests ();
+
+        float impact;
+
+        obstacle_index.find_first_impact (obstacles, player, 0.f, 0.f, time, impact);
+
+        if (settings.find_pairs)
+        {
+            pairs.clear ();
+
+            obstacle_index.find_pairs (pairs);
+        }
+
+        counters.obstacles = obstacles.size ();
+        counters.box_tests = obstacle_index.get_box_tests ();
+        counters.pairs     = unsigned(pairs.size ());
+    }
+
+    void Obstacle_Stress::Report::add (const Counters & counters, double update_seconds, double render_seconds, unsigned draw_calls)
+    {
+        frames++;
+
+        this->obstacles      += counters.obstacles;
+        this->update_seconds += update_seconds;
+        this->render_seconds += render_seconds;
+        this->draw_calls     += draw_calls;
+        this->box_tests      += double(counters.box_tests);
+        this->pairs          += counters.pairs;
+    }
+
+    std::string Obstacle_Stress::Report::header ()
+    {
+        char buffer[128];
+
+        std::snprintf (buffer, sizeof(buffer), "%9s %9s %10s %10s %10s %11s %10s", "spawn/s", "obstacles", "update ms", "render ms", "draw calls", "box tests", "pairs");
+
+        return buffer;
+    }
+
+    std::string Obstacle_Stress::Report::line (float spawn_rate, bool rendered) const
+    {
+        char   buffer[128];
+        double count = frames > 0 ? double(frames) : 1.0;
+
+        if (rendered)
+        {
+            std::snprintf
+            (
+                buffer, sizeof(buffer), "%9.0f %9.0f %10.3f %10.3f %10.1f %11.0f %10.0f",
+                spawn_rate, obstacles / count, update_seconds * 1e3 / count, render_seconds * 1e3 / count, draw_calls / count, box_tests / count, pairs / count
+            );
+        }
+        else
+        {
+            std::snprintf
+            (
+                buffer, sizeof(buffer), "%9.0f %9.0f %10.3f %10s %10s %11.0f %10.0f",
+                spawn_rate, obstacles / count, update_seconds * 1e3 / count, "-", "-", box_tests / count, pairs / count
+            );
+        }
+
+        return buffer;
+    }
+
+}
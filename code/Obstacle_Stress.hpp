@@ -0,0 +1,124 @@
+/*
+ * OBSTACLE STRESS
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#ifndef OBSTACLE_STRESS_HEADER
+#define OBSTACLE_STRESS_HEADER
+
+    #include <cstdint>
+    #include <string>
+    #include <vector>
+    #include <basics/Random>
+    #include <basics/Size>
+
+    #include "Collision_Index.hpp"
+    #include "Sprite_Store.hpp"
+
+    namespace flythecopter
+    {
+
+        using basics::Random;
+
+        /*
+         * Prueba de carga con los obstáculos del juego: hace aparecer miles de obstáculos por segundo
+         * de tamaños y velocidades variados, los mueve, recicla los que salen de la pantalla y en cada
+         * paso hace las mismas consultas de colisión que Game_Simulation (el barrido de un jugador)
+         * más la búsqueda de todas las parejas de obstáculos que se solapan. Como Game_Simulation, no
+         * usa Canvas ni relojes del sistema, así que la usan tanto Stress_Scene en el dispositivo como
+         * la herramienta stress-benchmark de Linux.
+         */
+        class Obstacle_Stress
+        {
+        public:
+
+            struct Settings
+            {
+                float    spawn_rate;                // Obstáculos que aparecen por segundo.
+                unsigned capacity;                  // Máximo de obstáculos a la vez (si el pool está lleno no aparecen más).
+                float    min_size;                  // Lado mínimo de los obstáculos.
+                float    max_size;                  // Lado máximo de los obstáculos.
+                float    min_speed;                 // Velocidad mínima hacia la izquierda (en px/s).
+                float    max_speed;                 // Velocidad máxima hacia la izquierda (en px/s).
+                bool     find_pairs;                // Si es true también se buscan las parejas de obstáculos que se solapan.
+            };
+
+            static const Settings default_settings;
+
+            // Trabajo hecho en el último paso:
+            struct Counters
+            {
+                unsigned obstacles;                 // Obstáculos activos al final del paso.
+                unsigned spawned;                   // Obstáculos que han aparecido.
+                unsigned dropped;                   // Obstáculos que no han aparecido por estar lleno el pool.
+                uint64_t box_tests;                 // Cajas comparadas en la fase estrecha.
+                unsigned pairs;                     // Parejas de obstáculos que se solapan.
+            };
+
+            /*
+             * Medias de varios fotogramas con las que se forma una línea del informe. Los tiempos los
+             * mide quien avanza y dibuja la prueba.
+             */
+            struct Report
+            {
+                unsigned frames;
+                double   obstacles;
+                double   update_seconds;
+                double   render_seconds;
+                double   draw_calls;
+                double   box_tests;
+                double   pairs;
+
+                void add (const Counters & counters, double update_seconds, double render_seconds, unsigned draw_calls);
+
+                static std::string header ();
+
+                // Línea con las medias por fotograma. Sin 'rendered' no se muestran los datos de dibujado.
+                std::string line (float spawn_rate, bool rendered) const;
+            };
+
+        private:
+
+            float           world_width;
+            float           world_height;
+            Settings        settings;
+
+            Sprite_Store    obstacles;              // Pool de capacidad fija con los obstáculos activos.
+            Collision_Index obstacle_index;
+            std::vector< Collision_Index::Pair > pairs;
+
+            Random          random;
+            float           pending;                // Obstáculos que deberían haber aparecido y aún no lo han hecho (fracción).
+            Sprite_Store::Bounds player;            // Caja de un jugador quieto con la que se comprueban los choques.
+            Counters        counters;
+
+        public:
+
+            Obstacle_Stress(const basics::Size2f & world_size, const Settings & settings = default_settings, uint64_t seed = 1);
+
+            // Cambia el número de obstáculos que aparecen por segundo (el resto de la configuración es fija).
+            void set_spawn_rate (float spawn_rate)
+            {
+                settings.spawn_rate = spawn_rate;
+            }
+
+            // Elimina todos los obstáculos.
+            void clear ();
+
+            // Avanza la prueba 'time' segundos.
+            void step (float time);
+
+            const Settings     & get_settings  () const { return settings;  }
+            const Counters     & get_counters  () const { return counters;  }
+            const Sprite_Store & get_obstacles () const { return obstacles; }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,215 @@
+/*
+ * OVERLAP KERNEL
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#include "Overlap_Kernel.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define FLYTHECOPTER_SSE_KERNEL
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define FLYTHECOPTER_NEON_KERNEL
+    #include <arm_neon.h>
+#endif
+
+namespace flythecopter
+{
+
+    namespace
+    {
+
+        // Dos cajas se solapan si cada una empieza antes de que termine la otra en ambos ejes (es la
+        // misma condición que Sprite_Store::overlap() escrita sin negaciones):
+
+        inline uint32_t overlap_bit (const Sprite_Store::Bounds & box, const Packed_Bounds & boxes, unsigned index)
+        {
+            return uint32_t
+            (
+                (boxes.left  [index] < box.right) & (boxes.right[index] > box.left  ) &
+                (boxes.bottom[index] < box.top  ) & (boxes.top  [index] > box.bottom)
+            );
+        }
+
+        #if defined(FLYTHECOPTER_SSE_KERNEL)
+
+            // Devuelve en los 4 bits bajos el resultado de comprobar las cajas index..index+3:
+
+            struct Overlap_Test
+            {
+                __m128 left, bottom, right, top;
+
+                Overlap_Test(const Sprite_Store::Bounds & box)
+                :
+                    left  (_mm_set1_ps (box.left  )),
+                    bottom(_mm_set1_ps (box.bottom)),
+                    right (_mm_set1_ps (box.right )),
+                    top   (_mm_set1_ps (box.top   ))
+                {
+                }
+
+                uint32_t operator () (const Packed_Bounds & boxes, unsigned index) const
+                {
+                    __m128 x = _mm_and_ps
+                    (
+                        _mm_cmplt_ps (_mm_loadu_ps (boxes.left   + index), right ),
+                        _mm_cmpgt_ps (_mm_loadu_ps (boxes.right  + index), left  )
+                    );
+
+                    __m128 y = _mm_and_ps
+                    (
+                        _mm_cmplt_ps (_mm_loadu_ps (boxes.bottom + index), top   ),
+                        _mm_cmpgt_ps (_mm_loadu_ps (boxes.top    + index), bottom)
+                    );
+
+                    return uint32_t(_mm_movemask_ps (_mm_and_ps (x, y)));
+                }
+            };
+
+        #elif defined(FLYTHECOPTER_NEON_KERNEL)
+
+            struct Overlap_Test
+            {
+                float32x4_t left, bottom, right, top;
+                uint32x4_t  weights;
+
+                Overlap_Test(const Sprite_Store::Bounds & box)
+                :
+                    left   (vdupq_n_f32 (box.left  )),
+                    bottom (vdupq_n_f32 (box.bottom)),
+                    right  (vdupq_n_f32 (box.right )),
+                    top    (vdupq_n_f32 (box.top   ))
+                {
+                    static const uint32_t bits[] = { 1, 2, 4, 8 };
+
+                    weights = vld1q_u32 (bits);
+                }
+
+                uint32_t operator () (const Packed_Bounds & boxes, unsigned index) const
+                {
+                    uint32x4_t x = vandq_u32
+                    (
+                        vcltq_f32 (vld1q_f32 (boxes.left   + index), right ),
+                        vcgtq_f32 (vld1q_f32 (boxes.right  + index), left  )
+                    );
+
+                    uint32x4_t y = vandq_u32
+                    (
+                        vcltq_f32 (vld1q_f32 (boxes.bottom + index), top   ),
+                        vcgtq_f32 (vld1q_f32 (boxes.top    + index), bottom)
+                    );
+
+                    // Se convierte cada carril (todo unos o todo ceros) en su bit y se suman los 4:
+
+                    uint32x4_t lanes = vandq_u32 (vandq_u32 (x, y), weights);
+                    uint32x2_t pairs = vadd_u32  (vget_low_u32 (lanes), vget_high_u32 (lanes));
+
+                    return vget_lane_u32 (vpadd_u32 (pairs, pairs), 0);
+                }
+            };
+
+        #else
+
+            struct Overlap_Test
+            {
+                const Sprite_Store::Bounds & box;
+
+                Overlap_Test(const Sprite_Store::Bounds & box) : box(box)
+                {
+                }
+
+                uint32_t operator () (const Packed_Bounds & boxes, unsigned index) const
+                {
+                    return
+                        (overlap_bit (box, boxes, index + 0) << 0) |
+                        (overlap_bit (box, boxes, index + 1) << 1) |
+                        (overlap_bit (box, boxes, index + 2) << 2) |
+                        (overlap_bit (box, boxes, index + 3) << 3);
+                }
+            };
+
+        #endif
+
+        inline unsigned count_bits (uint32_t bits)
+        {
+            unsigned count = 0;
+
+            for ( ; bits; bits &= bits - 1) count++;
+
+            return count;
+        }
+
+    }
+
+    unsigned find_overlap_mask (const Sprite_Store::Bounds & box, const Packed_Bounds & boxes, unsigned count, uint32_t * mask)
+    {
+        Overlap_Test test(box);
+        unsigned     hits  = 0;
+        unsigned     index = 0;
+
+        // Las cajas se comprueban de 4 en 4. Como 32 es múltiplo de 4, cada grupo cae entero dentro
+        // de una palabra de la máscara:
+
+        for ( ; index + 32 <= count; index += 32)
+        {
+            uint32_t bits =
+                (test (boxes, index +  0) <<  0) | (test (boxes, index +  4) <<  4) |
+                (test (boxes, index +  8) <<  8) | (test (boxes, index + 12) << 12) |
+                (test (boxes, index + 16) << 16) | (test (boxes, index + 20) << 20) |
+                (test (boxes, index + 24) << 24) | (test (boxes, index + 28) << 28);
+
+            *mask++ = bits;
+            hits   += count_bits (bits);
+        }
+
+        // La última palabra puede quedar incompleta:
+
+        if (index < count)
+        {
+            uint32_t bits  = 0;
+            unsigned shift = 0;
+
+            for ( ; index + 4 <= count; index += 4, shift += 4) bits |= test        (boxes, index) << shift;
+            for ( ; index     <  count; index += 1, shift += 1) bits |= overlap_bit (box, boxes, index) << shift;
+
+            *mask = bits;
+            hits += count_bits (bits);
+        }
+
+        return hits;
+    }
+
+    unsigned find_first_overlap (const Sprite_Store::Bounds & box, const Packed_Bounds & boxes, unsigned count)
+    {
+        Overlap_Test test(box);
+        unsigned     index = 0;
+
+        for ( ; index + 4 <= count; index += 4)
+        {
+            uint32_t bits = test (boxes, index);
+
+            if (bits)
+            {
+                while (!(bits & 1)) { bits >>= 1; index++; }
+
+                return index;
+            }
+        }
+
+        for ( ; index < count; ++index)
+        {
+            if (overlap_bit (box, boxes, index))
+            {
+                return index;
+            }
+        }
+
+        return Sprite_Store::npos;
+    }
+
+}
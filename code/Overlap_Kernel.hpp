@@ -0,0 +1,59 @@
+/*
+ * OVERLAP KERNEL
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#ifndef OVERLAP_KERNEL_HEADER
+#define OVERLAP_KERNEL_HEADER
+
+    #include <cstdint>
+
+    #include "Sprite_Store.hpp"
+
+    namespace flythecopter
+    {
+
+        /*
+         * Cajas envolventes guardadas como estructura de arrays: el elemento i de cada array
+         * corresponde a la caja i. Los arrays no son propiedad de esta estructura.
+         */
+        struct Packed_Bounds
+        {
+            const float * left;
+            const float * bottom;
+            const float * right;
+            const float * top;
+        };
+
+        // Número de palabras de 32 bits que necesita una máscara con un bit por cada una de 'count' cajas.
+        inline unsigned overlap_mask_words (unsigned count)
+        {
+            return (count + 31) / 32;
+        }
+
+        /*
+         * Comprueba si una caja se solapa con cada una de las cajas de un array empaquetado. Se usan
+         * instrucciones SSE o NEON cuando están disponibles para comprobar 4 cajas a la vez, sin saltos.
+         * @param box Caja que se compara con todas las demás.
+         * @param boxes Cajas con las que se compara.
+         * @param count Número de cajas en los arrays.
+         * @param mask Máscara de salida con overlap_mask_words(count) palabras. El bit i % 32 de la
+         *     palabra i / 32 queda a 1 si la caja i se solapa con 'box'.
+         * @return Número de cajas que se solapan con 'box'.
+         */
+        unsigned find_overlap_mask (const Sprite_Store::Bounds & box, const Packed_Bounds & boxes, unsigned count, uint32_t * mask);
+
+        /*
+         * Busca la primera caja del array empaquetado que se solapa con 'box'.
+         * @return El índice de la caja o Sprite_Store::npos si no se solapa con ninguna.
+         */
+        unsigned find_first_overlap (const Sprite_Store::Bounds & box, const Packed_Bounds & boxes, unsigned count);
+
+    }
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ * SIMULATION BATCH
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#include "Simulation_Batch.hpp"
+
+namespace flythecopter
+{
+
+    Simulation_Batch::Simulation_Batch
+    (
+        unsigned               instances,
+        const basics::Size2f & world_size,
+        const basics::Size2f & player_size,
+        uint64_t               seed,
+        unsigned               threads
+    )
+    :
+        inputs (instances, 0),
+        games  (instances, 0)
+    {
+        auto_restart = true;
+        generation   = 0;
+        pending      = 0;
+        exiting      = false;
+        step_time    = 0.f;
+        step_ticks   = 0;
+
+        step_range      = nullptr;
+        step_controller = nullptr;
+
+        simulations.reserve (instances);
+
+        for (unsigned instance = 0; instance < instances; ++instance)
+        {
+            simulations.emplace_back (world_size);
+
+            Game_Simulation & simulation = simulations.back ();
+
+            simulation.set_seed       (seed + instance);
+            simulation.create_sprites (player_size);
+            simulation.restart        ();
+            simulation.start_playing  ();
+        }
+
+        if (threads == 0)
+        {
+            threads = std::thread::hardware_concurrency ();
+        }
+
+        // No tiene sentido tener más hilos que partidas:
+
+        if (threads > instances) threads = instances;
+        if (threads < 1        ) threads = 1;
+
+        // El bloque 0 lo simula el hilo que llama a step() y cada hilo de trabajo uno de los siguientes:
+
+        for (unsigned block = 1; block < threads; ++block)
+        {
+            workers.emplace_back (&Simulation_Batch::worker_function, this, block);
+        }
+    }
+
+    Simulation_Batch::~Simulation_Batch()
+    {
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            exiting = true;
+        }
+
+        start_barrier.notify_all ();
+
+        for (auto & worker : workers)
+        {
+            worker.join ();
+        }
+    }
+
+    void Simulation_Batch::run_step (float time, unsigned ticks, Range_Function range, const void * controller)
+    {
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            step_time       = time;
+            step_ticks      = ticks;
+            step_range      = range;
+            step_controller = controller;
+            pending         = unsigned(workers.size ());
+
+            generation++;
+        }
+
+        start_barrier.notify_all ();
+
+        run_block (0);
+
+        std::unique_lock< std::mutex > lock(mutex);
+
+        done_barrier.wait (lock, [this] { return pending == 0; });
+    }
+
+    void Simulation_Batch::run_block (unsigned block)
+    {
+        unsigned blocks = get_thread_count ();
+        unsigned count  = size ();
+
+        step_range (*this, unsigned(uint64_t(count) * block / blocks), unsigned(uint64_t(count) * (block + 1) / blocks), step_controller);
+    }
+
+    void Simulation_Batch::worker_function (unsigned block)
+    {
+        unsigned last_generation = 0;
+
+        for (;;)
+        {
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+
+                start_barrier.wait (lock, [&] { return exiting || generation != last_generation; });
+
+                if (exiting) return;
+
+                last_generation = generation;
+            }
+
+            run_block (block);
+
+            bool last_one;
+
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                last_one = --pending == 0;
+            }
+
+            if (last_one) done_barrier.notify_one ();
+        }
+    }
+
+}
@@ -0,0 +1,192 @@
+/*
+ * SIMULATION BATCH
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#ifndef SIMULATION_BATCH_HEADER
+#define SIMULATION_BATCH_HEADER
+
+    #include <condition_variable>
+    #include <cstdint>
+    #include <mutex>
+    #include <thread>
+    #include <vector>
+
+    #include "Game_Simulation.hpp"
+
+    namespace flythecopter
+    {
+
+        /*
+         * Conjunto de partidas independientes (Game_Simulation) que avanzan a la vez repartidas entre
+         * varios hilos. Cada partida tiene su propia semilla y su propia entrada (si se toca la
+         * pantalla o no). Cada hilo se ocupa siempre del mismo bloque contiguo de partidas, por lo que
+         * no comparten datos mientras simulan y el resultado no depende del número de hilos.
+         *
+         * Las partidas solo van a la par entre llamadas a step(): dentro de una llamada cada partida
+         * avanza todos sus pasos seguidos antes de pasar a la siguiente, así que un controlador no
+         * puede ver en qué paso van las demás.
+         */
+        class Simulation_Batch
+        {
+
+            // Simula las partidas [first, last) con el controlador de la llamada actual a step():
+            typedef void (* Range_Function) (Simulation_Batch & batch, unsigned first, unsigned last, const void * controller);
+
+        private:
+
+            std::vector< Game_Simulation > simulations;     // Las partidas.
+            std::vector< uint8_t         > inputs;          // Entrada de cada partida cuando no hay controlador.
+            std::vector< unsigned        > games;           // Partidas terminadas en cada instancia.
+
+            bool                           auto_restart;    // Si es true, las partidas que terminan vuelven a empezar.
+
+            std::vector< std::thread >     workers;         // Hilos de trabajo (el hilo que llama a step() también simula).
+            std::mutex                     mutex;
+            std::condition_variable        start_barrier;   // Avisa a los hilos de que hay trabajo nuevo.
+            std::condition_variable        done_barrier;    // Avisa al hilo que llamó a step() de que todos han terminado.
+            unsigned                       generation;      // Se incrementa con cada llamada a step().
+            unsigned                       pending;         // Hilos de trabajo que aún no han terminado el paso actual.
+            bool                           exiting;
+
+            float                          step_time;       // Tiempo de cada paso de la llamada actual a step().
+            unsigned                       step_ticks;      // Número de pasos de la llamada actual a step().
+            Range_Function                 step_range;      // Bucle de simulación para el tipo de controlador de la llamada actual.
+            const void                   * step_controller; // Controlador de la llamada actual.
+
+        public:
+
+            /*
+             * Crea las partidas y los hilos. Las partidas empiezan ya en juego.
+             * @param instances Número de partidas.
+             * @param world_size Tamaño de la zona de juego (el de la resolución virtual de Game_Scene).
+             * @param player_size Tamaño del jugador (el de su textura).
+             * @param seed Semilla de la primera partida. La partida i usa seed + i.
+             * @param threads Número total de hilos (incluido el que llama a step()). Con 0 se usa el
+             *     número de núcleos del procesador.
+             */
+            Simulation_Batch
+            (
+                unsigned               instances,
+                const basics::Size2f & world_size,
+                const basics::Size2f & player_size,
+                uint64_t               seed,
+                unsigned               threads = 0
+            );
+
+           ~Simulation_Batch();
+
+            Simulation_Batch(const Simulation_Batch & ) = delete;
+            Simulation_Batch & operator = (const Simulation_Batch & ) = delete;
+
+        public:
+
+            unsigned size () const
+            {
+                return unsigned(simulations.size ());
+            }
+
+            unsigned get_thread_count () const
+            {
+                return unsigned(workers.size ()) + 1;
+            }
+
+            const Game_Simulation & get (unsigned instance) const
+            {
+                return simulations[instance];
+            }
+
+            // Número de partidas que han terminado en una instancia (solo cuenta si auto_restart está activo).
+            unsigned get_games (unsigned instance) const
+            {
+                return games[instance];
+            }
+
+            void set_seed (unsigned instance, uint64_t seed)
+            {
+                simulations[instance].set_seed (seed);
+            }
+
+            // Restablece en una instancia un estado guardado con Game_Simulation::save().
+            bool restore (unsigned instance, const Game_Simulation::Snapshot & snapshot)
+            {
+                return simulations[instance].restore (snapshot);
+            }
+
+            void set_flying (unsigned instance, bool flying)
+            {
+                inputs[instance] = flying;
+            }
+
+            void set_auto_restart (bool enabled)
+            {
+                auto_restart = enabled;
+            }
+
+            /*
+             * Avanza todas las partidas con la entrada fijada con set_flying() y espera a que terminen.
+             * @param time Tiempo de cada paso (normalmente 1 / Game_Simulation::tick_rate).
+             * @param ticks Número de pasos que avanza cada partida.
+             */
+            void step (float time, unsigned ticks = 1)
+            {
+                step (time, ticks, [this] (unsigned instance, const Game_Simulation & ) { return inputs[instance] != 0; });
+            }
+
+            /*
+             * Avanza todas las partidas decidiendo la entrada de cada una en cada paso con
+             * controller (instance, simulation), que devuelve true si se toca la pantalla. Como el
+             * bucle de simulación se genera para cada tipo de controlador, la llamada se puede
+             * expandir en línea. Se llama desde los hilos de trabajo, así que solo debe leer la
+             * partida que recibe y modificar datos de esa misma instancia.
+             */
+            template< typename CONTROLLER >
+            void step (float time, unsigned ticks, const CONTROLLER & controller)
+            {
+                run_step (time, ticks, &run_range< CONTROLLER >, &controller);
+            }
+
+        private:
+
+            template< typename CONTROLLER >
+            static void run_range (Simulation_Batch & batch, unsigned first, unsigned last, const void * controller)
+            {
+                const CONTROLLER & decide = *static_cast< const CONTROLLER * >(controller);
+
+                // Cada partida avanza todos los pasos seguidos antes de pasar a la siguiente para que su
+                // estado se mantenga en la caché mientras se simula:
+
+                for (unsigned instance = first; instance < last; ++instance)
+                {
+                    Game_Simulation & simulation = batch.simulations[instance];
+
+                    for (unsigned tick = 0; tick < batch.step_ticks; ++tick)
+                    {
+                        simulation.set_flying (decide (instance, simulation));
+                        simulation.step       (batch.step_time);
+
+                        if (batch.auto_restart && simulation.get_gameplay () == Game_Simulation::GAME_OVER)
+                        {
+                            batch.games[instance]++;
+
+                            simulation.restart       ();
+                            simulation.start_playing ();
+                        }
+                    }
+                }
+            }
+
+            void run_step        (float time, unsigned ticks, Range_Function range, const void * controller);
+            void run_block       (unsigned block);
+            void worker_function (unsigned block);
+
+        };
+
+    }
+
+#endif
@@ -25,56 +25,43 @@ namespace flythecopter
         scale    = 1.f;
         speed    = { 0.f, 0.f };
         visible  = true;
+
+        invalidate_bounds ();
     }
 
-    bool Sprite::intersects (const Sprite & other)
+    void Sprite::update_bounds () const
     {
-        // Se determinan las coordenadas de la esquina inferior izquierda y de la superior derecha
-        // de este sprite:
+        float width  = size.width  * scale;
+        float height = size.height * scale;
 
-        float this_left    = this->get_left_x   ();
-        float this_bottom  = this->get_bottom_y ();
-        float this_right   = this_left   + this->size.width;
-        float this_top     = this_bottom + this->size.height;
+        float left   =
+            (anchor & 0x3) == basics::LEFT   ? position[0] :
+            (anchor & 0x3) == basics::RIGHT  ? position[0] - width :
+             position[0] - width * .5f;
 
-        // Se determinan las coordenadas de la esquina inferior izquierda y de la superior derecha
-        // del otro sprite:
+        float bottom =
+            (anchor & 0xC) == basics::BOTTOM ? position[1] :
+            (anchor & 0xC) == basics::TOP    ? position[1] - height :
+             position[1] - height * .5f;
 
-        float other_left   = other.get_left_x   ();
-        float other_bottom = other.get_bottom_y ();
-        float other_right  = other_left   + other.size.width;
-        float other_top    = other_bottom + other.size.height;
+        bounds       = { left, bottom, left + width, bottom + height };
+        bounds_dirty = false;
+    }
 
+    bool Sprite::intersects (const Sprite & other)
+    {
         // Se determina si los rectángulos envolventes de ambos sprites se solapan:
 
-        return !(other_left >= this_right || other_right <= this_left || other_bottom >= this_top || other_top <= this_bottom);
+        return Sprite_Store::overlap (this->get_bounds (), other.get_bounds ());
     }
 
     bool Sprite::contains (const Point2f & point)
     {
-        float this_left = this->get_left_x ();
-
-        if (point.coordinates.x () > this_left)
-        {
-            float this_bottom = this->get_bottom_y ();
-
-            if (point.coordinates.y () > this_bottom)
-            {
-                float this_right = this_left + this->size.width;
-
-                if (point.coordinates.x () < this_right)
-                {
-                    float this_top = this_bottom + this->size.height;
-
-                    if (point.coordinates.y () < this_top)
-                    {
-                        return true;
-                    }
-                }
-            }
-        }
+        const Bounds & box = get_bounds ();
 
-        return false;
+        return
+            point.coordinates.x () > box.left   && point.coordinates.x () < box.right &&
+            point.coordinates.y () > box.bottom && point.coordinates.y () < box.top;
     }
 
 }
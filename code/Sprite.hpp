@@ -16,6 +16,8 @@
     #include <basics/Texture_2D>
     #include <basics/Vector>
 
+    #include "Sprite_Store.hpp"
+
     namespace flythecopter
     {
 
@@ -27,6 +29,10 @@
 
         class Sprite
         {
+        public:
+
+            typedef Sprite_Store::Bounds Bounds;
+
         protected:
 
             Texture_2D * texture;                   // Textura en la que está la imagen del sprite.
@@ -40,6 +46,11 @@
 
             bool         visible;                   // Indica si el sprite se debe actualizar y dibujar o no. Por defecto es true.
 
+        private:
+
+            mutable Bounds bounds;                  // Caja envolvente calculada a partir de anchor, position, size y scale.
+            mutable bool   bounds_dirty;            // Indica si 'bounds' se debe volver a calcular antes de leerla.
+
         public:
 
             /*
@@ -65,31 +76,22 @@
             const float    & get_speed_x    () const { return  speed[0];    }
             const float    & get_speed_y    () const { return  speed[1];    }
 
-            float get_left_x () const
-            {
-                return
-                    (anchor & 0x3) == basics::LEFT  ? position[0] :
-                    (anchor & 0x3) == basics::RIGHT ? position[0] - size[0] :
-                     position[0] - size[0] * .5f;
-            }
-
-            float get_right_x () const
+            /*
+             * Devuelve la caja envolvente del sprite (con la escala aplicada). Solo se vuelve a
+             * calcular cuando ha cambiado el anclaje, la posición, el tamaño o la escala, por lo que
+             * colisiones y dibujado comparten la misma caja sin recalcularla en cada consulta.
+             */
+            const Bounds & get_bounds () const
             {
-                return get_left_x () + size.width;
-            }
+                if (bounds_dirty) update_bounds ();
 
-            float get_bottom_y () const
-            {
-                return
-                    (anchor & 0xC) == basics::BOTTOM ? position[1] :
-                    (anchor & 0xC) == basics::TOP    ? position[1] - size[1] :
-                     position[1] - size[1] * .5f;
+                return bounds;
             }
 
-            float get_top_y () const
-            {
-                return get_bottom_y () + size.height;
-            }
+            float get_left_x   () const { return get_bounds ().left;   }
+            float get_right_x  () const { return get_bounds ().right;  }
+            float get_bottom_y () const { return get_bounds ().bottom; }
+            float get_top_y    () const { return get_bounds ().top;    }
 
             bool is_visible () const
             {
@@ -107,32 +109,38 @@
             void set_anchor (int new_anchor)
             {
                 anchor = new_anchor;
+                invalidate_bounds ();
             }
 
             void set_position (const Point2f & new_position)
             {
                 position = new_position;
+                invalidate_bounds ();
             }
 
             // Cambia el tamaño del sprite
             void set_size (const Size2f & new_size)
             {
                 size = new_size;
+                invalidate_bounds ();
             }
 
             void set_position_x (const float & new_position_x)
             {
                 position.coordinates.x () = new_position_x;
+                invalidate_bounds ();
             }
 
             void set_position_y (const float & new_position_y)
             {
                 position.coordinates.y () = new_position_y;
+                invalidate_bounds ();
             }
 
             void set_scale (float new_scale)
             {
                 scale = new_scale;
+                invalidate_bounds ();
             }
 
             void set_speed (const Vector2f & new_speed)
@@ -150,6 +158,19 @@
                 speed.coordinates.y () = new_speed_y;
             }
 
+        protected:
+
+            // Las clases derivadas que modifiquen directamente anchor, position, size o scale deben
+            // llamar a este método para que la caja envolvente se vuelva a calcular.
+            void invalidate_bounds ()
+            {
+                bounds_dirty = true;
+            }
+
+        private:
+
+            void update_bounds () const;
+
         public:
 
 
@@ -199,6 +220,8 @@
 
                     position.coordinates.x () += displacement.coordinates.x ();
                     position.coordinates.y () += displacement.coordinates.y ();
+
+                    invalidate_bounds ();
                 }
             }
 
@@ -210,7 +233,9 @@
             {
                 if (visible)
                 {
-                    canvas.fill_rectangle (position, size * scale, texture, anchor);
+                    const Bounds & box = get_bounds ();
+
+                    canvas.fill_rectangle ({ box.left, box.bottom }, { box.right - box.left, box.top - box.bottom }, texture, basics::BOTTOM | basics::LEFT);
                 }
             }
 
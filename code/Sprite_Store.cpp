@@ -0,0 +1,256 @@
+/*
+ * SPRITE STORE
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#include "Overlap_Kernel.hpp"
+#include "Sprite_Store.hpp"
+
+using namespace basics;
+
+namespace flythecopter
+{
+
+    constexpr uint32_t Sprite_Store::npos;
+
+    Sprite_Store::Sprite_Store(unsigned capacity)
+    :
+        capacity   (capacity),
+        allocations(0)
+    {
+        reserve (position_x     , capacity);
+        reserve (position_y     , capacity);
+        reserve (width          , capacity);
+        reserve (height         , capacity);
+        reserve (speed_x        , capacity);
+        reserve (speed_y        , capacity);
+        reserve (anchor         , capacity);
+        reserve (visible        , capacity);
+        reserve (texture_id     , capacity);
+        reserve (offset_x       , capacity);
+        reserve (offset_y       , capacity);
+        reserve (bounds_left    , capacity);
+        reserve (bounds_bottom  , capacity);
+        reserve (bounds_right   , capacity);
+        reserve (bounds_top     , capacity);
+        reserve (dense_to_slot  , capacity);
+        reserve (slot_to_dense  , capacity);
+        reserve (slot_generation, capacity);
+        reserve (free_slots     , capacity);
+
+        // Todos los slots se crean libres desde el principio. Se apilan al revés para que los
+        // primeros sprites ocupen los primeros slots:
+
+        slot_to_dense  .assign (capacity, npos);
+        slot_generation.assign (capacity, 0);
+
+        for (unsigned slot = capacity; slot-- > 0; )
+        {
+            free_slots.push_back (slot);
+        }
+    }
+
+    Sprite_Store::Handle Sprite_Store::create (Id new_texture_id, const Size2f & new_size)
+    {
+        if (is_full ())
+        {
+            return { npos, 0 };
+        }
+
+        // Se reutiliza un slot libre o, si no queda ninguno, se añade uno nuevo:
+
+        uint32_t slot;
+
+        if (free_slots.empty ())
+        {
+            slot = uint32_t(slot_to_dense.size ());
+
+            push (slot_to_dense  , npos);
+            push (slot_generation, 0u  );
+        }
+        else
+        {
+            slot = free_slots.back ();
+
+            free_slots.pop_back ();
+        }
+
+        // El nuevo sprite se añade al final de los arrays densos:
+
+        slot_to_dense[slot] = size ();
+
+        push (position_x   , 0.f                );
+        push (position_y   , 0.f                );
+        push (width        , new_size.width     );
+        push (height       , new_size.height    );
+        push (speed_x      , 0.f                );
+        push (speed_y      , 0.f                );
+        push (anchor       , int(basics::CENTER));
+        push (visible      , uint8_t(1)         );
+        push (texture_id   , new_texture_id     );
+        push (dense_to_slot, slot               );
+        push (offset_x     , 0.f                );
+        push (offset_y     , 0.f                );
+        push (bounds_left  , 0.f                );
+        push (bounds_bottom, 0.f                );
+        push (bounds_right , 0.f                );
+        push (bounds_top   , 0.f                );
+
+        refresh_bounds (size () - 1);
+
+        return { slot, slot_generation[slot] };
+    }
+
+    void Sprite_Store::destroy (Handle handle)
+    {
+        if (is_valid (handle))
+        {
+            destroy_at (index_of (handle));
+        }
+    }
+
+    void Sprite_Store::destroy_at (unsigned index)
+    {
+        unsigned last = size () - 1;
+        uint32_t slot = dense_to_slot[index];
+
+        // Se mueve el último sprite al hueco que deja el eliminado para que los arrays sigan siendo densos:
+
+        if (index != last)
+        {
+            position_x   [index] = position_x   [last];
+            position_y   [index] = position_y   [last];
+            width        [index] = width        [last];
+            height       [index] = height       [last];
+            speed_x      [index] = speed_x      [last];
+            speed_y      [index] = speed_y      [last];
+            anchor       [index] = anchor       [last];
+            visible      [index] = visible      [last];
+            texture_id   [index] = texture_id   [last];
+            dense_to_slot[index] = dense_to_slot[last];
+            offset_x     [index] = offset_x     [last];
+            offset_y     [index] = offset_y     [last];
+            bounds_left  [index] = bounds_left  [last];
+            bounds_bottom[index] = bounds_bottom[last];
+            bounds_right [index] = bounds_right [last];
+            bounds_top   [index] = bounds_top   [last];
+
+            slot_to_dense[dense_to_slot[index]] = index;
+        }
+
+        position_x   .pop_back ();
+        position_y   .pop_back ();
+        width        .pop_back ();
+        height       .pop_back ();
+        speed_x      .pop_back ();
+        speed_y      .pop_back ();
+        anchor       .pop_back ();
+        visible      .pop_back ();
+        texture_id   .pop_back ();
+        dense_to_slot.pop_back ();
+        offset_x     .pop_back ();
+        offset_y     .pop_back ();
+        bounds_left  .pop_back ();
+        bounds_bottom.pop_back ();
+        bounds_right .pop_back ();
+        bounds_top   .pop_back ();
+
+        // Se libera el slot incrementando su generación para invalidar los handles que lo apunten:
+
+        slot_to_dense  [slot] = npos;
+        slot_generation[slot]++;
+
+        push (free_slots, slot);
+    }
+
+    void Sprite_Store::clear ()
+    {
+        while (size () > 0)
+        {
+            destroy_at (size () - 1);
+        }
+    }
+
+    void Sprite_Store::refresh_bounds (unsigned index)
+    {
+        float w = width [index];
+        float h = height[index];
+        int   a = anchor[index];
+
+        // El anclaje solo cambia de vez en cuando, así que se guarda ya convertido en desplazamientos
+        // desde la posición y update() no tiene que volver a interpretarlo:
+
+        offset_x[index] = (a & 0x3) == basics::LEFT   ? 0.f : (a & 0x3) == basics::RIGHT ? -w : -w * .5f;
+        offset_y[index] = (a & 0xC) == basics::BOTTOM ? 0.f : (a & 0xC) == basics::TOP   ? -h : -h * .5f;
+
+        bounds_left  [index] = position_x[index] + offset_x[index];
+        bounds_bottom[index] = position_y[index] + offset_y[index];
+        bounds_right [index] = bounds_left  [index] + w;
+        bounds_top   [index] = bounds_bottom[index] + h;
+    }
+
+    unsigned Sprite_Store::find_overlap (const Bounds & bounds) const
+    {
+        // Se buscan solapamientos con el kernel y se descartan los de sprites invisibles:
+
+        for (unsigned first = 0, count = size (); first < count; )
+        {
+            Packed_Bounds boxes{ get_lefts () + first, get_bottoms () + first, get_rights () + first, get_tops () + first };
+
+            unsigned found = find_first_overlap (bounds, boxes, count - first);
+
+            if (found == npos)
+            {
+                break;
+            }
+
+            if (visible[first + found])
+            {
+                return first + found;
+            }
+
+            first += found + 1;
+        }
+
+        return npos;
+    }
+
+    void Sprite_Store::update (float time)
+    {
+        // Los arrays se recorren de forma lineal y sin saltos para que el compilador pueda vectorizar
+        // el bucle. Los sprites invisibles se integran con velocidad nula:
+
+              float   * x  = position_x.data ();
+              float   * y  = position_y.data ();
+        const float   * vx = speed_x   .data ();
+        const float   * vy = speed_y   .data ();
+        const uint8_t * v  = visible   .data ();
+        const float   * w  = width     .data ();
+        const float   * h  = height    .data ();
+        const float   * ox = offset_x  .data ();
+        const float   * oy = offset_y  .data ();
+              float   * l  = bounds_left  .data ();
+              float   * b  = bounds_bottom.data ();
+              float   * r  = bounds_right .data ();
+              float   * t  = bounds_top   .data ();
+
+        for (unsigned index = 0, count = size (); index < count; ++index)
+        {
+            float step = v[index] ? time : 0.f;
+
+            x[index] += vx[index] * step;
+            y[index] += vy[index] * step;
+
+            l[index]  = x[index] + ox[index];
+            b[index]  = y[index] + oy[index];
+            r[index]  = l[index] + w [index];
+            t[index]  = b[index] + h [index];
+        }
+    }
+
+}
@@ -0,0 +1,345 @@
+/*
+ * SPRITE STORE
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#ifndef SPRITE_STORE_HEADER
+#define SPRITE_STORE_HEADER
+
+    #include <cstdint>
+    #include <vector>
+    #include <basics/Canvas>
+    #include <basics/Id>
+    #include <basics/Point>
+    #include <basics/Size>
+
+    namespace flythecopter
+    {
+
+        using basics::Id;
+        using basics::Size2f;
+        using basics::Point2f;
+
+        /*
+         * Almacén de sprites organizado como estructura de arrays: cada propiedad se guarda en un
+         * array contiguo propio, de modo que actualizar, recortar o comprobar colisiones es un
+         * recorrido lineal sobre floats empaquetados.
+         * Los arrays son densos (no tienen huecos). Al eliminar un sprite se mueve el último a su
+         * lugar, por lo que los índices densos cambian; para referirse a un sprite de forma estable
+         * se usan Handle, que se traducen a índice denso a través de una tabla de slots.
+         * Si se construye con una capacidad fija, toda la memoria se reserva al crearlo y los slots
+         * de los sprites eliminados se reciclan, por lo que crear y eliminar sprites no vuelve a
+         * reservar memoria dinámica.
+         * La caja envolvente de cada sprite se guarda ya calculada en cuatro arrays empaquetados (uno
+         * por borde). Se recalcula al cambiar el anclaje, la posición o el tamaño y al avanzar en
+         * update(), de modo que colisiones, recorte y dibujado leen las mismas cajas sin volver a
+         * interpretar el anclaje.
+         */
+        class Sprite_Store
+        {
+        public:
+
+            // Valor usado para indicar "ningún índice":
+            static constexpr uint32_t npos = ~uint32_t(0);
+
+            // Referencia estable a un sprite. La generación permite detectar handles de sprites eliminados.
+            struct Handle
+            {
+                uint32_t slot;
+                uint32_t generation;
+            };
+
+            // Caja envolvente alineada con los ejes.
+            struct Bounds
+            {
+                float left;
+                float bottom;
+                float right;
+                float top;
+            };
+
+        private:
+
+            // Propiedades de los sprites (un elemento por sprite en cada array):
+
+            std::vector< float    > position_x;
+            std::vector< float    > position_y;
+            std::vector< float    > width;
+            std::vector< float    > height;
+            std::vector< float    > speed_x;
+            std::vector< float    > speed_y;
+            std::vector< int      > anchor;
+            std::vector< uint8_t  > visible;
+            std::vector< Id       > texture_id;
+
+            // Cajas envolventes calculadas (un elemento por sprite en cada array):
+
+            std::vector< float    > offset_x;       // Distancia desde la posición hasta el borde izquierdo (según el anclaje).
+            std::vector< float    > offset_y;       // Distancia desde la posición hasta el borde inferior (según el anclaje).
+            std::vector< float    > bounds_left;
+            std::vector< float    > bounds_bottom;
+            std::vector< float    > bounds_right;
+            std::vector< float    > bounds_top;
+
+            // Tabla de traducción entre handles e índices densos:
+
+            std::vector< uint32_t > dense_to_slot;
+            std::vector< uint32_t > slot_to_dense;
+            std::vector< uint32_t > slot_generation;
+            std::vector< uint32_t > free_slots;
+
+            unsigned capacity;                      // Número máximo de sprites (0 si el almacén puede crecer).
+            unsigned allocations;                   // Número de reservas de memoria dinámica hechas por el almacén.
+
+        public:
+
+            // Crea un almacén vacío que crece bajo demanda.
+            Sprite_Store()
+            {
+                capacity    = 0;
+                allocations = 0;
+            }
+
+            /*
+             * Crea un almacén de capacidad fija reservando de una vez toda la memoria que necesitará.
+             * @param capacity Número máximo de sprites que puede contener a la vez.
+             */
+            explicit Sprite_Store(unsigned capacity);
+
+        public:
+
+            /*
+             * Crea un nuevo sprite visible, parado, anclado por el centro y situado en (0,0).
+             * @param texture_id Id de la textura con la que se dibujará el sprite.
+             * @param size Tamaño del sprite (normalmente en coordenadas virtuales).
+             * @return Handle con el que referirse al nuevo sprite o un handle no válido si el almacén
+             *     tiene capacidad fija y está lleno.
+             */
+            Handle create (Id texture_id, const Size2f & size);
+
+            /*
+             * Elimina un sprite. No hace nada si el handle no es válido.
+             */
+            void destroy (Handle handle);
+
+            /*
+             * Elimina el sprite que ocupa un índice denso. El último sprite pasa a ocupar ese índice.
+             */
+            void destroy_at (unsigned index);
+
+            // Elimina todos los sprites. Los handles existentes dejan de ser válidos.
+            void clear ();
+
+            bool is_valid (Handle handle) const
+            {
+                return handle.slot < slot_generation.size () && slot_generation[handle.slot] == handle.generation && slot_to_dense[handle.slot] != npos;
+            }
+
+            unsigned size () const
+            {
+                return unsigned(position_x.size ());
+            }
+
+            bool is_full () const
+            {
+                return capacity > 0 && size () >= capacity;
+            }
+
+            // Número de reservas de memoria dinámica hechas desde que se creó el almacén.
+            unsigned get_allocation_count () const
+            {
+                return allocations;
+            }
+
+            unsigned index_of (Handle handle) const
+            {
+                return slot_to_dense[handle.slot];
+            }
+
+            // Número de slots de la tabla de handles (ocupados o libres).
+            unsigned get_slot_count () const
+            {
+                return unsigned(slot_to_dense.size ());
+            }
+
+            // Índice denso del sprite que ocupa un slot o npos si el slot está libre.
+            unsigned index_of_slot (uint32_t slot) const
+            {
+                return slot_to_dense[slot];
+            }
+
+        public:
+
+            // Acceso a los arrays densos para los recorridos lineales:
+
+            const float   * get_positions_x () const { return position_x.data (); }
+            const float   * get_positions_y () const { return position_y.data (); }
+            const float   * get_widths      () const { return width     .data (); }
+            const float   * get_heights     () const { return height    .data (); }
+            const float   * get_speeds_x    () const { return speed_x   .data (); }
+            const float   * get_speeds_y    () const { return speed_y   .data (); }
+            const int     * get_anchors     () const { return anchor    .data (); }
+            const uint8_t * get_visibility  () const { return visible   .data (); }
+            const Id      * get_texture_ids () const { return texture_id.data (); }
+            const uint32_t* get_slots       () const { return dense_to_slot.data (); }
+            const float   * get_lefts       () const { return bounds_left  .data (); }
+            const float   * get_bottoms     () const { return bounds_bottom.data (); }
+            const float   * get_rights      () const { return bounds_right .data (); }
+            const float   * get_tops        () const { return bounds_top   .data (); }
+
+        public:
+
+            // Getters y setters a través de handle (con nombres autoexplicativos):
+
+            Point2f get_position   (Handle handle) const { unsigned i = index_of (handle); return { position_x[i], position_y[i] }; }
+            float   get_position_x (Handle handle) const { return position_x[index_of (handle)]; }
+            float   get_position_y (Handle handle) const { return position_y[index_of (handle)]; }
+            Size2f  get_size       (Handle handle) const { unsigned i = index_of (handle); return { width[i], height[i] }; }
+            float   get_speed_x    (Handle handle) const { return speed_x[index_of (handle)]; }
+            float   get_speed_y    (Handle handle) const { return speed_y[index_of (handle)]; }
+            bool    is_visible     (Handle handle) const { return visible[index_of (handle)] != 0; }
+
+            void set_anchor   (Handle handle, int new_anchor)
+            {
+                unsigned i = index_of (handle);
+
+                anchor[i] = new_anchor;
+
+                refresh_bounds (i);
+            }
+            void set_position (Handle handle, const Point2f & new_position)
+            {
+                unsigned i = index_of (handle);
+
+                position_x[i] = new_position[0];
+                position_y[i] = new_position[1];
+
+                refresh_bounds (i);
+            }
+            void set_size     (Handle handle, const Size2f & new_size)
+            {
+                unsigned i = index_of (handle);
+
+                width [i] = new_size.width;
+                height[i] = new_size.height;
+
+                refresh_bounds (i);
+            }
+            void set_speed_x  (Handle handle, float new_speed_x) { speed_x[index_of (handle)] = new_speed_x; }
+            void set_speed_y  (Handle handle, float new_speed_y) { speed_y[index_of (handle)] = new_speed_y; }
+            void hide         (Handle handle) { visible[index_of (handle)] = 0; }
+            void show         (Handle handle) { visible[index_of (handle)] = 1; }
+
+        public:
+
+            // Caja envolvente (ya calculada) del sprite que ocupa un índice denso.
+            Bounds get_bounds_at (unsigned index) const
+            {
+                return { bounds_left[index], bounds_bottom[index], bounds_right[index], bounds_top[index] };
+            }
+
+            Bounds get_bounds (Handle handle) const
+            {
+                return get_bounds_at (index_of (handle));
+            }
+
+            static bool overlap (const Bounds & a, const Bounds & b)
+            {
+                return !(b.left >= a.right || b.right <= a.left || b.bottom >= a.top || b.top <= a.bottom);
+            }
+
+            bool intersects (Handle a, Handle b) const
+            {
+                return overlap (get_bounds (a), get_bounds (b));
+            }
+
+            /*
+             * Prueba de colisión continua: comprueba si la caja 'a', al desplazarse (dx, dy), llega a
+             * solaparse con la caja 'b' (que no se mueve). Para dos cajas en movimiento se pasa el
+             * desplazamiento de 'a' relativo al de 'b'.
+             * @param time_of_impact Fracción del desplazamiento (entre 0 y 1) en la que empiezan a
+             *     solaparse (0 si ya se solapaban al principio).
+             * @return true si se solapan en algún momento del desplazamiento.
+             */
+            static bool sweep (const Bounds & a, float dx, float dy, const Bounds & b, float & time_of_impact)
+            {
+                // Se calcula en cada eje el intervalo de tiempo en el que las proyecciones se solapan
+                // y se intersectan ambos intervalos:
+
+                float entry = -1.f, exit = 2.f;
+
+                if (!sweep_axis (a.left,   a.right, dx, b.left,   b.right, entry, exit)) return false;
+                if (!sweep_axis (a.bottom, a.top,   dy, b.bottom, b.top,   entry, exit)) return false;
+
+                if (entry >= exit || entry >= 1.f || exit <= 0.f) return false;
+
+                time_of_impact = entry > 0.f ? entry : 0.f;
+
+                return true;
+            }
+
+            /*
+             * Busca el primer sprite visible cuya caja envolvente se solapa con la indicada.
+             * @return El índice denso del sprite encontrado o npos si no se solapa con ninguno.
+             */
+            unsigned find_overlap (const Bounds & bounds) const;
+
+        private:
+
+            // Reduce [entry, exit) al intervalo en el que el segmento [a0, a1) desplazado 'd' se solapa con [b0, b1).
+            static bool sweep_axis (float a0, float a1, float d, float b0, float b1, float & entry, float & exit)
+            {
+                if (d == 0.f)
+                {
+                    return a0 < b1 && a1 > b0;
+                }
+
+                float t0 = (b0 - a1) / d;
+                float t1 = (b1 - a0) / d;
+
+                if (t0 > t1) { float t = t0; t0 = t1; t1 = t; }
+
+                if (t0 > entry) entry = t0;
+                if (t1 < exit ) exit  = t1;
+
+                return true;
+            }
+
+            // Vuelve a calcular la caja envolvente de un sprite tras cambiar su anclaje, posición o tamaño.
+            void refresh_bounds (unsigned index);
+
+            // Añade un valor a un array contando la reserva de memoria si no cabe en la capacidad actual.
+            template< typename TYPE >
+            void push (std::vector< TYPE > & array, const TYPE & value)
+            {
+                if (array.size () == array.capacity ()) allocations++;
+
+                array.push_back (value);
+            }
+
+            template< typename TYPE >
+            void reserve (std::vector< TYPE > & array, unsigned count)
+            {
+                if (array.capacity () < count) allocations++;
+
+                array.reserve (count);
+            }
+
+        public:
+
+            /*
+             * Actualiza la posición y la caja envolvente de todos los sprites visibles en función de su velocidad.
+             * @param time Fracción de tiempo que se debe avanzar.
+             */
+            void update (float time);
+
+        };
+
+    }
+
+#endif
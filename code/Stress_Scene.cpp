@@ -0,0 +1,199 @@
+/*
+ * STRESS SCENE
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#include "Stress_Scene.hpp"
+#include "Menu_Scene.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <basics/Director>
+#include <basics/Log>
+#include <basics/Timer>
+
+using namespace basics;
+using namespace std;
+
+namespace flythecopter
+{
+
+    Stress_Scene::Stress_Scene(const Levels & levels)
+    :
+        canvas_width (1280),
+        canvas_height( 720),
+        stress       ({ 1280.f, 720.f }),
+        levels       (levels)
+    {
+        initialize ();
+    }
+
+    bool Stress_Scene::initialize ()
+    {
+        state          = LOADING;
+        suspended      = true;
+        level          = 0;
+        level_time     = 0.f;
+        report         = Obstacle_Stress::Report{};
+        update_seconds = 0.0;
+
+        state_changes         = 0.0;
+        skipped_state_changes = 0.0;
+
+        stress.clear          ();
+        stress.set_spawn_rate (levels.first_rate);
+
+        finished_levels.clear ();
+
+        return true;
+    }
+
+    void Stress_Scene::handle (Event & event)
+    {
+        if (state != LOADING && event.id == ID(touch-ended))
+        {
+            director.run_scene (shared_ptr< Scene >(new Menu_Scene));
+        }
+    }
+
+    void Stress_Scene::update (float time)
+    {
+        if (suspended) return;
+
+        if (state == LOADING)
+        {
+            Graphics_Context::Accessor context = director.lock_graphics_context ();
+
+            if (context)
+            {
+                wall_texture = Texture_2D::create (ID(wall), context, "game-scene/wall.png");
+
+                if (wall_texture)
+                {
+                    context->add (wall_texture);
+
+                    basics::log.i ("stress: " + Obstacle_Stress::Report::header ());
+
+                    state = RUNNING;
+                }
+                else
+                    state = ERROR;
+            }
+        }
+        else if (state == RUNNING)
+        {
+            // Tras una pausa larga no se simula de golpe todo el tiempo perdido:
+
+            time = std::min (time, 1.f / 15.f);
+
+            Timer timer;
+
+            stress.step (time);
+
+            update_seconds = timer.get_elapsed_seconds< double > ();
+            level_time    += time;
+
+            if (level_time >= levels.duration) finish_level ();
+        }
+    }
+
+    void Stress_Scene::finish_level ()
+    {
+        basics::log.i ("stress: " + report.line (stress.get_settings ().spawn_rate, true));
+
+        finished_levels.push_back ({ stress.get_settings ().spawn_rate, report });
+
+        if (report.frames > 0)
+        {
+            char line[96];
+
+            std::snprintf (line, sizeof(line), "stress: gl state changes/frame: %.1f issued, %.1f skipped", state_changes / report.frames, skipped_state_changes / report.frames);
+
+            basics::log.i (line);
+        }
+
+        if (++level >= levels.count)
+        {
+            director.run_scene (shared_ptr< Scene >(new Menu_Scene));
+            return;
+        }
+
+        level_time = 0.f;
+        report     = Obstacle_Stress::Report{};
+
+        state_changes         = 0.0;
+        skipped_state_changes = 0.0;
+
+        stress.set_spawn_rate (stress.get_settings ().spawn_rate * 2.f);
+    }
+
+    void Stress_Scene::render (Context & context)
+    {
+        if (suspended) return;
+
+        Canvas * canvas = context->get_renderer< Canvas > (ID(canvas));
+
+        if (!canvas)
+        {
+            canvas = Canvas::create (ID(canvas), context, {{ canvas_width, canvas_height }});
+        }
+
+        if (canvas)
+        {
+            canvas->set_batching (true);
+            canvas->clear        ();
+
+            if (state == RUNNING)
+            {
+                // Se mide lo que tarda la CPU en preparar el dibujo (la GPU trabaja después). Las
+                // llamadas de dibujo son las del fotograma anterior, que es el último completo:
+
+                Timer timer;
+
+                render_obstacles (*canvas);
+
+                double render_seconds = timer.get_elapsed_seconds< double > ();
+
+                if (level_time >= levels.duration / 2.f)
+                {
+                    Canvas::Statistics statistics = canvas->get_statistics ();
+
+                    report.add (stress.get_counters (), update_seconds, render_seconds, statistics.draw_calls);
+
+                    state_changes         += statistics.state_changes;
+                    skipped_state_changes += statistics.skipped_state_changes;
+                }
+            }
+        }
+    }
+
+    void Stress_Scene::render_obstacles (Canvas & canvas)
+    {
+        const Sprite_Store & obstacles = stress.get_obstacles ();
+
+        const float * lefts   = obstacles.get_lefts   ();
+        const float * bottoms = obstacles.get_bottoms ();
+        const float * rights  = obstacles.get_rights  ();
+        const float * tops    = obstacles.get_tops    ();
+
+        for (unsigned index = 0, count = obstacles.size (); index < count; ++index)
+        {
+            if (rights[index] > 0.f && lefts[index] < canvas_width && tops[index] > 0.f && bottoms[index] < canvas_height)
+            {
+                canvas.fill_rectangle
+                (
+                    { lefts[index], bottoms[index] },
+                    { rights[index] - lefts[index], tops[index] - bottoms[index] },
+                    wall_texture.get (),
+                    BOTTOM | LEFT
+                );
+            }
+        }
+    }
+
+}
@@ -0,0 +1,129 @@
+/*
+ * STRESS SCENE
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+#ifndef STRESS_SCENE_HEADER
+#define STRESS_SCENE_HEADER
+
+    #include <memory>
+    #include <vector>
+    #include <basics/Canvas>
+    #include <basics/Scene>
+    #include <basics/Texture_2D>
+
+    #include "Obstacle_Stress.hpp"
+
+    namespace flythecopter
+    {
+
+        using basics::Canvas;
+        using basics::Texture_2D;
+
+        /*
+         * Variante de Game_Scene para medir hasta dónde llega el motor: dibuja los obstáculos de
+         * Obstacle_Stress con la textura de los del juego y duplica el número de obstáculos que
+         * aparecen por segundo en cada nivel. Al terminar cada nivel escribe en el log una línea con
+         * las medias por fotograma (obstáculos, tiempo de actualización y de dibujo, llamadas de
+         * dibujo y comprobaciones de colisión), con el mismo formato que stress-benchmark en Linux.
+         * Al tocar la pantalla o terminar el último nivel se vuelve al menú.
+         */
+        class Stress_Scene : public basics::Scene
+        {
+
+            typedef basics::Graphics_Context::Accessor Context;
+
+            enum State
+            {
+                LOADING,
+                RUNNING,
+                ERROR
+            };
+
+        public:
+
+            // Configuración de los niveles:
+            struct Levels
+            {
+                float    first_rate;                    // Obstáculos por segundo del primer nivel.
+                unsigned count;                         // Número de niveles.
+                float    duration;                      // Segundos que dura cada nivel (solo se mide la segunda mitad).
+            };
+
+            // Medias de un nivel terminado:
+            struct Level_Report
+            {
+                float                   spawn_rate;
+                Obstacle_Stress::Report report;
+            };
+
+        private:
+
+            State           state;
+            bool            suspended;
+
+            unsigned        canvas_width;
+            unsigned        canvas_height;
+
+            Obstacle_Stress stress;
+            Levels          levels;
+            unsigned        level;                      // Nivel actual.
+            float           level_time;                 // Tiempo transcurrido en el nivel actual.
+
+            Obstacle_Stress::Report report;             // Medias del nivel actual.
+            double          update_seconds;             // Tiempo que ha tardado la última actualización.
+            double          state_changes;              // Cambios de estado del contexto gráfico hechos en el nivel actual.
+            double          skipped_state_changes;      // Cambios de estado evitados por redundantes en el nivel actual.
+
+            std::vector< Level_Report > finished_levels;    // Informes de los niveles terminados (stress-benchmark los muestra).
+
+            std::shared_ptr< Texture_2D > wall_texture;
+
+        public:
+
+            Stress_Scene(const Levels & levels = { 500.f, 6, 8.f });
+
+            basics::Size2u get_view_size () override
+            {
+                return { canvas_width, canvas_height };
+            }
+
+            bool initialize () override;
+
+            void suspend () override
+            {
+                suspended = true;
+            }
+
+            void resume () override
+            {
+                suspended = false;
+            }
+
+            void handle (basics::Event & event) override;
+            void update (float time) override;
+            void render (Context & context) override;
+
+            const std::vector< Level_Report > & get_finished_levels () const
+            {
+                return finished_levels;
+            }
+
+        private:
+
+            // Escribe en el log el informe del nivel actual y pasa al siguiente.
+            void finish_level ();
+
+            // Dibuja los obstáculos que se ven en pantalla.
+            void render_obstacles (Canvas & canvas);
+
+        };
+
+    }
+
+#endif
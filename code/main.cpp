@@ -8,14 +8,16 @@
  * angel.rodriguez@esne.edu
  */
 
+#include <basics/Application>
 #include <basics/Director>
 #include <basics/enable>
 #include <basics/Graphics_Resource_Cache>
 #include <basics/opengles/Context>
 #include <basics/Window>
 #include "Intro_Scene.hpp"
-#include <basics/opengles/Canvas_ES2>
-#include <basics/opengles/OpenGL_ES2>
+#include "Game_Scene.hpp"
+#include <basics/opengles/Canvas_ES3>
+#include <basics/opengles/OpenGL_ES3>
 
 using namespace basics;
 using namespace flythecopter;
@@ -23,13 +25,24 @@ using namespace std;
 
 int main ()
 {
-    // Es necesario habilitar un backend gráfico antes de nada:
+    // Es necesario habilitar un backend gráfico antes de nada. El de OpenGL ES 3 usa instancing para
+    // dibujar los sprites y recurre al canvas de OpenGL ES 2 en los dispositivos que no lo soportan:
 
-    enable< basics::OpenGL_ES2 > ();
+    enable< basics::OpenGL_ES3 > ();
 
-    // Se crea una Game_Scene y se inicia mediante el Director:
+    // Se crea la escena inicial y se inicia mediante el Director. Si el sistema cerró la aplicación
+    // en mitad de una partida, se continúa directamente esa partida:
 
-    director.run_scene (shared_ptr< Scene >(new Intro_Scene));
+    if (Game_Scene::has_saved_game ())
+    {
+        Game_Scene * game_scene = new Game_Scene;
+
+        game_scene->set_autopilot (application.get_launch_option ("autopilot") == "1");
+
+        director.run_scene (shared_ptr< Scene >(game_scene));
+    }
+    else
+        director.run_scene (shared_ptr< Scene >(new Intro_Scene));
 
     return 0;
 }
@@ -46,5 +59,6 @@ void keep_links ()
     Graphics_Resource_Cache cache;
     opengles::Context::create(window, &cache);
     Canvas::Factory f = opengles::Canvas_ES2::create;
+    Canvas::Factory g = opengles::Canvas_ES3::create;
     Texture_2D::register_factory ( 0 , 0 );
 }
\ No newline at end of file
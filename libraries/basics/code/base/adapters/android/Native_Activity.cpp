@@ -19,6 +19,8 @@
     #include "Android_Accelerometer.hpp"
     #include "Native_Activity.hpp"
 
+    #include <cstdlib>
+    #include <cstring>
     #include <basics/Log>
     using namespace basics;
 
@@ -196,6 +198,15 @@
             application.clear_events ();
             application.set_state    (Application::ACTIVE);
 
+            // If the activity is being recreated, the state saved by the previous instance is made
+            // available to the scenes:
+
+            application.set_saved_state (saved_activity_state, saved_activity_state ? saved_state_size : 0);
+
+            // The extras of the intent are read before main() starts:
+
+            read_launch_options ();
+
             // AÑADIR UN EVENTO RESTART CUANDO CORRESPONDA...
 
             // Se incializa el gestor de sensores:
@@ -228,6 +239,64 @@
             }
         }
 
+        // -----------------------------------------------------------------------------------------
+        // Copies the extras of the intent that launched the activity to the launch options of the
+        // application (as text). It must be called from the UI thread, which owns activity.env.
+
+        void Native_Activity::read_launch_options ()
+        {
+            JNIEnv  * env    = activity.env;
+            jobject   intent = env->CallObjectMethod (activity.clazz, env->GetMethodID (env->GetObjectClass (activity.clazz), "getIntent", "()Landroid/content/Intent;"));
+            jobject   extras = intent ? env->CallObjectMethod (intent, env->GetMethodID (env->GetObjectClass (intent), "getExtras", "()Landroid/os/Bundle;")) : nullptr;
+
+            if (env->ExceptionCheck ())
+            {
+                env->ExceptionClear ();
+                return;
+            }
+
+            if (extras)
+            {
+                jclass       bundle_class = env->GetObjectClass (extras);
+                jmethodID    get          = env->GetMethodID    (bundle_class, "get", "(Ljava/lang/String;)Ljava/lang/Object;");
+                jmethodID    to_string    = env->GetMethodID    (env->FindClass ("java/lang/Object"), "toString", "()Ljava/lang/String;");
+                jobject      key_set      = env->CallObjectMethod (extras, env->GetMethodID (bundle_class, "keySet", "()Ljava/util/Set;"));
+                jobjectArray keys         = static_cast< jobjectArray >(env->CallObjectMethod (key_set, env->GetMethodID (env->GetObjectClass (key_set), "toArray", "()[Ljava/lang/Object;")));
+
+                auto text = [env] (jobject string) -> std::string
+                {
+                    const char  * chars = env->GetStringUTFChars (static_cast< jstring >(string), nullptr);
+                    std::string   copy  = chars ? chars : "";
+
+                    if (chars) env->ReleaseStringUTFChars (static_cast< jstring >(string), chars);
+
+                    return copy;
+                };
+
+                for (jsize index = 0, count = keys ? env->GetArrayLength (keys) : 0; index < count; ++index)
+                {
+                    jobject key   = env->GetObjectArrayElement (keys, index);
+                    jobject value = env->CallObjectMethod (extras, get, key);
+
+                    if (value)
+                    {
+                        jobject value_text = env->CallObjectMethod (value, to_string);
+
+                        application.set_launch_option (text (key), text (value_text));
+
+                        env->DeleteLocalRef (value_text);
+                        env->DeleteLocalRef (value);
+                    }
+
+                    env->DeleteLocalRef (key);
+                }
+            }
+
+            // A failure here only means that there are no launch options:
+
+            if (env->ExceptionCheck ()) env->ExceptionClear ();
+        }
+
         // -----------------------------------------------------------------------------------------
 
         void Native_Activity::on_start ()
@@ -253,6 +322,10 @@
 
             application.set_state (Application::SUSPENDED);
 
+            // The scene saves its state when it handles SUSPEND, which on_save_activity_state() waits for:
+
+            application.expect_saved_state ();
+
             application.push (Event(Application::Event_Id::SUSPEND));
         }
 
@@ -306,8 +379,23 @@
 
         void * Native_Activity::on_save_activity_state (size_t & out_size)
         {
-            out_size = 0;
-            return nullptr;
+            // The main thread may not have suspended the scene yet. The wait is bounded so that a busy
+            // main thread can't make the UI thread stop responding:
+
+            if (!application.wait_for_saved_state (std::chrono::milliseconds(1000)))
+            {
+                log.w ("the saved state may be outdated (the scene didn't suspend in time)");
+            }
+
+            std::vector< uint8_t > saved_state = application.get_saved_state ();
+
+            void * copy = saved_state.empty () ? nullptr : malloc (saved_state.size ());
+
+            if (copy) memcpy (copy, saved_state.data (), saved_state.size ());
+
+            out_size = copy ? saved_state.size () : 0;
+
+            return copy;
         }
 
         // -----------------------------------------------------------------------------------------
@@ -124,6 +124,8 @@
             void  input_thread_function ();
             void sensor_thread_function ();
 
+            void read_launch_options ();
+
         public:
 
             /// NativeActivity has started.
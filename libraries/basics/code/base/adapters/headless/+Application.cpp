@@ -0,0 +1,38 @@
+/*
+ * APPLICATION
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101215
+ */
+
+#include <basics/macros>
+
+#if !defined(BASICS_ANDROID_OS)
+
+    #include "Headless_Application.hpp"
+
+    namespace basics
+    {
+
+        namespace internal
+        {
+
+            Headless_Application application;
+
+        }
+
+        Application & Application::get_instance ()
+        {
+            return internal::application;
+        }
+
+        Application & application = Application::get_instance ();
+
+    }
+
+#endif
@@ -0,0 +1,45 @@
+/*
+ * LOG
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101230
+ */
+
+#include <basics/macros>
+
+#if !defined(BASICS_ANDROID_OS)
+
+    #include <cstdio>
+    #include <basics/Log>
+
+    namespace basics
+    {
+
+        static const char headless_log_priorities[] =
+        {
+            'V',
+            'D',
+            'I',
+            'W',
+            'E',
+            'F',
+        };
+
+        // Warnings and errors go to the standard error so that they are not mixed with the output
+        // of the tools:
+
+        void Log::dump (Level level, const char * tag, const char * cstring)
+        {
+            std::fprintf (level >= WARNING ? stderr : stdout, "%c/%s: %s\n", headless_log_priorities[level], tag ? tag : "*", cstring);
+        }
+
+        Log log;
+
+    }
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * WINDOW
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101225
+ */
+
+#include <basics/macros>
+
+#if !defined(BASICS_ANDROID_OS)
+
+    #include "Headless_Window.hpp"
+
+    namespace basics
+    {
+
+        // The virtual window has the size of the view of the scenes of the game, so that no scaling
+        // is applied to the coordinates of the touch events:
+
+        static const Size2u headless_window_size{ 1280, 720 };
+
+        static std::shared_ptr< Window > headless_window;
+
+        const bool Window::can_be_instantiated = true;
+
+        Window::Handle Window::create_window (Id id)
+        {
+            if (id == default_window_id && !headless_window)
+            {
+                headless_window.reset (new internal::Headless_Window(id, headless_window_size));
+            }
+
+            return get_window (id);
+        }
+
+        bool Window::destroy_window (Id id)
+        {
+            if (id == default_window_id && headless_window)
+            {
+                headless_window.reset ();
+
+                return true;
+            }
+
+            return false;
+        }
+
+        Window::Handle Window::get_window (Id id)
+        {
+            if (id == default_window_id && headless_window)
+            {
+                return Handle(headless_window);
+            }
+
+            return Handle();
+        }
+
+    }
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ * HEADLESS APPLICATION
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101210
+ */
+
+#ifndef BASICS_HEADLESS_APPLICATION_HEADER
+#define BASICS_HEADLESS_APPLICATION_HEADER
+
+    #include <basics/Application>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * Application of the desktop builds, that have neither a display nor a window manager. It
+         * is interactive from the beginning and it announces the (virtual) window right away, so
+         * that the Director starts running scenes on the first frame.
+         */
+        class Headless_Application : public Application
+        {
+        public:
+
+            Headless_Application()
+            {
+                push (Event(RESUME        ));
+                push (Event(WINDOW_CREATED));
+            }
+
+        public:
+
+            State get_state () const override
+            {
+                return INTERACTIVE;
+            }
+
+        };
+
+        extern Headless_Application application;
+
+    }}
+
+#endif
@@ -0,0 +1,159 @@
+/*
+ * HEADLESS ASSET
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101240
+ */
+
+#include <basics/macros>
+
+#if !defined(BASICS_ANDROID_OS)
+
+    #include "Headless_Asset.hpp"
+    #include <basics/headless/Headless>
+
+    namespace basics { namespace internal
+    {
+
+        Headless_Asset::Headless_Asset(const std::string & path)
+        {
+            const std::string & asset_path = headless::get_asset_path ();
+
+            handle = std::fopen ((asset_path.empty () ? path : asset_path + '/' + path).c_str (), "rb");
+            cursor = 0;
+            length = 0;
+            failed = handle == nullptr;
+            at_end = false;
+
+            if (handle != nullptr)
+            {
+                if (std::fseek (handle, 0, SEEK_END) == 0)
+                {
+                    long end = std::ftell (handle);
+
+                    if (end >= 0) length = size_t(end);
+                }
+
+                std::rewind (handle);
+            }
+        }
+
+        Headless_Asset::~Headless_Asset()
+        {
+            if (handle != nullptr)
+            {
+                std::fclose (handle), handle = nullptr;
+            }
+        }
+
+        bool Headless_Asset::good () const
+        {
+            return not failed;
+        }
+
+        bool Headless_Asset::fail () const
+        {
+            return failed;
+        }
+
+        bool Headless_Asset::eof () const
+        {
+            return at_end;
+        }
+
+        size_t Headless_Asset::size () const
+        {
+            return good () ? length : 0;
+        }
+
+        bool Headless_Asset::seek (ptrdiff_t offset, Anchor anchor)
+        {
+            if (good ())
+            {
+                if (std::fseek (handle, long(offset), anchor == BEGINNING ? SEEK_SET : anchor == END ? SEEK_END : SEEK_CUR) == 0)
+                {
+                    cursor = size_t(std::ftell (handle));
+                    at_end = false;
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        size_t Headless_Asset::tell () const
+        {
+            return cursor;
+        }
+
+        byte Headless_Asset::read ()
+        {
+            byte data = 0;
+
+            if (good ())
+            {
+                read (&data, 1);
+            }
+
+            return data;
+        }
+
+        bool Headless_Asset::read_all (std::vector< byte > & buffer)
+        {
+            if (good () && seek (0, BEGINNING))
+            {
+                buffer.resize (length);
+
+                return read (buffer.data (), length);
+            }
+
+            return false;
+        }
+
+        bool Headless_Asset::read_all (std::string & buffer)
+        {
+            if (good () && seek (0, BEGINNING))
+            {
+                buffer.resize (length);
+
+                return read ((uint8_t *)buffer.data (), length);
+            }
+
+            return false;
+        }
+
+        bool Headless_Asset::read (uint8_t * buffer, size_t size)
+        {
+            if (size > 0)
+            {
+                size_t result = std::fread (buffer, 1, size, handle);
+
+                cursor += result;
+
+                if (result == size)
+                {
+                    return true;
+                }
+                else
+                if (std::feof (handle))
+                {
+                    at_end = true;
+                }
+                else
+                    failed = true;
+
+                return false;
+            }
+
+            return true;
+        }
+
+    }}
+
+#endif
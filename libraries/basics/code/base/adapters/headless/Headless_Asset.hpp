@@ -0,0 +1,61 @@
+/*
+ * HEADLESS ASSET
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101235
+ */
+
+#ifndef BASICS_HEADLESS_ASSET_HEADER
+#define BASICS_HEADLESS_ASSET_HEADER
+
+    #include <cstdio>
+    #include <basics/Asset>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * Asset read from a regular file. The paths are relative to the directory set with
+         * headless::set_asset_path(), that plays the role of the assets folder of the APK.
+         */
+        class Headless_Asset final : public Asset
+        {
+
+            std::FILE * handle;
+            size_t      cursor;
+            size_t      length;
+            bool        failed;
+            bool        at_end;
+
+        public:
+
+            Headless_Asset(const std::string & path);
+           ~Headless_Asset();
+
+        public:
+
+            bool   good () const override;
+            bool   fail () const override;
+            bool   eof  () const override;
+
+            size_t size () const override;
+            bool   seek (ptrdiff_t offset, Anchor = CURRENT) override;
+            size_t tell () const override;
+            byte   read () override;
+            bool   read_all (std::vector< byte > & buffer) override;
+            bool   read_all (std::string & buffer) override;
+
+        private:
+
+            bool read (uint8_t * buffer, size_t size);
+
+        };
+
+    }}
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ * HEADLESS WINDOW
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101220
+ */
+
+#ifndef BASICS_HEADLESS_WINDOW_HEADER
+#define BASICS_HEADLESS_WINDOW_HEADER
+
+    #include <basics/Window>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * Window with no real surface behind it. It is always available and focused, so graphics
+         * contexts that don't need a display (like the one of the headless backend) can be created
+         * for it.
+         */
+        class Headless_Window final : public Window
+        {
+
+            Size2u size;
+
+        public:
+
+            Headless_Window(Id id, const Size2u & size) : Window(id), size(size)
+            {
+                available = true;
+                focused   = true;
+
+                push (Event(GOT_FOCUS));
+            }
+
+        public:
+
+            Size2u get_size () override
+            {
+                return size;
+            }
+
+            unsigned get_width () override
+            {
+                return size.width;
+            }
+
+            unsigned get_height () override
+            {
+                return size.height;
+            }
+
+        };
+
+    }}
+
+#endif
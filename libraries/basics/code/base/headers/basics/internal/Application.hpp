@@ -13,7 +13,14 @@
 #ifndef BASICS_APPLICATION_HEADER
 #define BASICS_APPLICATION_HEADER
 
+    #include <chrono>
+    #include <condition_variable>
+    #include <cstdint>
+    #include <map>
     #include <memory>
+    #include <mutex>
+    #include <string>
+    #include <vector>
     #include <basics/Event_Queue>
 
     namespace basics
@@ -51,6 +58,13 @@
 
             Event_Queue event_queue;
 
+            std::mutex              saved_state_mutex;
+            std::condition_variable saved_state_condition;
+            std::vector< uint8_t >  saved_state;
+            bool                    saved_state_pending = false;
+
+            std::map< std::string, std::string > launch_options;
+
         protected:
 
             Application() = default;
@@ -77,6 +91,87 @@
                 return event_queue.poll (event);
             }
 
+        public:
+
+            /**
+             * Options given to the application when it was launched (on Android, the extras of the
+             * intent, as in "adb shell am start -n <package>/<activity> -e autopilot 1"). They are
+             * set by the platform before main() runs and don't change afterwards.
+             * @return The value of the option as text or an empty string if it wasn't given.
+             */
+            std::string get_launch_option (const std::string & name) const
+            {
+                auto option = launch_options.find (name);
+
+                return option != launch_options.end () ? option->second : std::string();
+            }
+
+            void set_launch_option (const std::string & name, const std::string & value)
+            {
+                launch_options[name] = value;
+            }
+
+        public:
+
+            /**
+             * Stores a copy of a block of plain data (it can't contain pointers) that the platform
+             * will persist if it decides to kill the application while it is in the background, and
+             * that will be available through get_saved_state() when the application is recreated.
+             * Scenes usually call it from suspend(). Passing a size of 0 clears the saved state.
+             */
+            void set_saved_state (const void * data, size_t size)
+            {
+                std::lock_guard< std::mutex > lock(saved_state_mutex);
+
+                saved_state.assign (static_cast< const uint8_t * >(data), static_cast< const uint8_t * >(data) + size);
+            }
+
+            void clear_saved_state ()
+            {
+                set_saved_state (nullptr, 0);
+            }
+
+            /**
+             * Returns a copy of the saved state (empty if there is none).
+             */
+            std::vector< uint8_t > get_saved_state ()
+            {
+                std::lock_guard< std::mutex > lock(saved_state_mutex);
+
+                return saved_state;
+            }
+
+            /**
+             * Handshake between the platform and the Director: the platform calls expect_saved_state()
+             * before sending SUSPEND, the Director calls saved_state_updated() once the current scene
+             * has handled it, and wait_for_saved_state() blocks until then (or until the timeout
+             * expires) so that the state persisted by the platform is the one written by suspend().
+             */
+            void expect_saved_state ()
+            {
+                std::lock_guard< std::mutex > lock(saved_state_mutex);
+
+                saved_state_pending = true;
+            }
+
+            void saved_state_updated ()
+            {
+                {
+                    std::lock_guard< std::mutex > lock(saved_state_mutex);
+
+                    saved_state_pending = false;
+                }
+
+                saved_state_condition.notify_all ();
+            }
+
+            bool wait_for_saved_state (std::chrono::milliseconds timeout)
+            {
+                std::unique_lock< std::mutex > lock(saved_state_mutex);
+
+                return saved_state_condition.wait_for (lock, timeout, [this] { return !saved_state_pending; });
+            }
+
         };
 
         extern Application & application;
@@ -13,6 +13,7 @@
 #ifndef BASICS_ATLAS_HEADER
 #define BASICS_ATLAS_HEADER
 
+    #include <cstdint>
     #include <map>
     #include <memory>
     #include <string>
@@ -40,21 +41,64 @@
                 float   top;
                 float   width;
                 float   height;
+                float   texture_left;                   // Las mismas coordenadas normalizadas (entre 0 y 1)
+                float   texture_right;                  // respecto al tamaño de la textura.
+                float   texture_bottom;
+                float   texture_top;
             };
 
+            /*
+             * Formato de las tablas de slices binarias que genera la herramienta atlas-builder: una
+             * cabecera, el nombre del archivo de la textura (relativo a la carpeta de la tabla, acabado
+             * en cero y con relleno hasta múltiplo de 4 bytes) y los slices ordenados por id. Los ids
+             * ya están calculados con fnv32 y las coordenadas de textura ya están normalizadas, por lo
+             * que la tabla se lee de una vez y no hay que interpretar nada. Los valores se guardan en
+             * el orden de bytes de la máquina (little endian tanto en Android como en Linux).
+             */
+
+            struct Table_Header
+            {
+                char     magic[4];                      // "ATLS"
+                uint32_t version;
+                uint32_t slice_count;
+                uint32_t texture_name_size;             // Incluye el cero final y el relleno.
+            };
+
+            struct Table_Record
+            {
+                uint32_t id;
+                float    left,         right,         bottom,         top;
+                float    width,        height;
+                float    texture_left, texture_right, texture_bottom, texture_top;
+            };
+
+            static constexpr uint32_t table_version = 1;
+
         private:
 
+            struct Table_Entry
+            {
+                Id    id;
+                Slice slice;
+            };
+
             typedef std::shared_ptr< Texture_2D > Texture_Handle;
             typedef std::map< Id, Slice >         Slice_Map;
+            typedef std::vector< Table_Entry >    Slice_Table;
             typedef std::vector< byte >           Buffer;
 
         private:
 
             Texture_Handle texture;
-            Slice_Map      slices;
+            Slice_Map      slices;                      // Slices del XML o añadidos con add_slice ().
+            Slice_Table    table;                       // Slices de una tabla binaria (ordenados por id).
 
         public:
 
+            /**
+             * Carga un atlas a partir de su archivo de slices, que puede ser un XML o una tabla binaria
+             * generada por atlas-builder (se distingue por la cabecera).
+             */
             Atlas(const std::string    & path, Graphics_Context::Accessor & context);
             Atlas(const Texture_Handle & texture);
 
@@ -62,7 +106,7 @@
 
             bool good () const
             {
-                return texture.get () != nullptr && slices.size () > 0;
+                return texture.get () != nullptr && (slices.size () > 0 || table.size () > 0);
             }
 
             const Texture_Handle & get_texture () const
@@ -72,6 +116,13 @@
 
             const Slice * get_slice (Id id) const
             {
+                if (!table.empty ())
+                {
+                    const Slice * slice = find_in_table (id);
+
+                    if (slice) return slice;
+                }
+
                 Slice_Map::const_iterator slice = slices.find (id);
 
                 return slice != slices.end () ? &slice->second : nullptr;
@@ -93,6 +144,11 @@
 
         private:
 
+            const Slice * find_in_table (Id id) const;
+
+            bool load_table (Buffer           & table_data,  const std::string & path, Graphics_Context::Accessor & context);
+            void load_texture (const std::string & name,    const std::string & path, Graphics_Context::Accessor & context);
+
             void parse     (Buffer           & slices_data, const std::string & path, Graphics_Context::Accessor & context);
             void parse_img (rapidxml::xml_node<> * img_tag, const std::string & path, Graphics_Context::Accessor & context);
             void parse_dir (rapidxml::xml_node<> * dir_tag, const std::string & prefix = std::string());
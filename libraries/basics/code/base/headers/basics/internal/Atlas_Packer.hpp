@@ -0,0 +1,163 @@
+/*
+ * ATLAS PACKER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802151030
+ */
+
+#ifndef BASICS_ATLAS_PACKER_HEADER
+#define BASICS_ATLAS_PACKER_HEADER
+
+    #include <map>
+    #include <memory>
+    #include <string>
+    #include <vector>
+    #include <basics/Atlas>
+    #include <basics/Color_Buffer>
+    #include <basics/Graphics_Context>
+    #include <basics/Id>
+
+    namespace basics
+    {
+
+        /**
+         * Junta varias imágenes PNG sueltas en una o pocas texturas (atlas) al cargarlas, de modo que
+         * se puedan dibujar con Canvas::fill_rectangle () a partir de sus slices sin cambiar de
+         * textura entre una y otra.
+         *
+         * Las imágenes se colocan con el algoritmo MaxRects (se mantiene la lista de los rectángulos
+         * libres más grandes posibles y cada imagen va en el que la deja más arriba) tras ordenarlas
+         * de más alta a más baja, de modo que las pequeñas rellenan los huecos que dejan las grandes.
+         * Cuando una imagen no cabe en el tamaño máximo se empieza un atlas nuevo. Alrededor de cada
+         * imagen se deja un margen en el que se repiten sus píxeles del borde para que el filtrado
+         * no mezcle imágenes vecinas.
+         */
+        class Atlas_Packer
+        {
+        public:
+
+            struct Options
+            {
+                unsigned max_width;                     // Tamaño máximo de cada atlas.
+                unsigned max_height;
+                unsigned padding;                       // Píxeles de margen alrededor de cada imagen.
+            };
+
+            static const Options default_options;
+
+            // Posición de una imagen dentro de las páginas que genera pack ():
+            struct Placement
+            {
+                Id       id;
+                unsigned page;                          // Índice de la página (atlas).
+                unsigned x;                             // Esquina superior izquierda (sin el margen).
+                unsigned y;
+                unsigned width;
+                unsigned height;
+            };
+
+            typedef Color_Buffer< Rgba8888 > Page;
+
+        private:
+
+            struct Image
+            {
+                Id                       id;
+                std::string              path;
+                Color_Buffer< Rgba8888 > pixels;
+                unsigned                 atlas;         // Índice del atlas en el que se coloca.
+                unsigned                 x;             // Esquina superior izquierda dentro del atlas (sin el margen).
+                unsigned                 y;
+
+                // La posición y el atlas se asignan al empaquetar:
+                Image(Id id, const std::string & path) : id(id), path(path), atlas(0), x(0), y(0)
+                {
+                }
+            };
+
+            struct Free_Rectangle
+            {
+                unsigned x;
+                unsigned y;
+                unsigned width;
+                unsigned height;
+            };
+
+            typedef std::shared_ptr< Atlas >           Atlas_Handle;
+            typedef std::vector< Free_Rectangle >      Free_List;
+            typedef std::map< Id, const Atlas::Slice * > Slice_Map;
+
+        private:
+
+            Options                     options;
+            std::vector< Image >        images;
+            std::vector< Atlas_Handle > atlases;
+            Slice_Map                   slices;
+
+        public:
+
+            Atlas_Packer(const Options & options = default_options)
+            :
+                options(options)
+            {
+            }
+
+        public:
+
+            /**
+             * Añade una imagen a la lista de las que se deben empaquetar.
+             * @param id Identificador con el que se obtendrá después su slice.
+             * @param asset_path Ruta del archivo PNG dentro de los assets.
+             */
+            void add (Id id, const std::string & asset_path)
+            {
+                images.push_back ({ id, asset_path });
+            }
+
+            /**
+             * Carga todas las imágenes añadidas, las coloca en uno o varios atlas, crea sus texturas y
+             * las añade al contexto gráfico.
+             * @return false si alguna imagen no se ha podido cargar o es mayor que el tamaño máximo.
+             */
+            bool pack (Graphics_Context::Accessor & context);
+
+            /**
+             * Carga y coloca las imágenes igual que la versión anterior, pero en lugar de crear las
+             * texturas retorna los píxeles de cada página y dónde ha quedado cada imagen (la usan las
+             * herramientas que generan los atlas por adelantado).
+             */
+            bool pack (std::vector< Page > & pages, std::vector< Placement > & placements);
+
+            /**
+             * Retorna el slice de una imagen empaquetada o nullptr si no existe o aún no se ha llamado
+             * a pack ().
+             */
+            const Atlas::Slice * get_slice (Id id) const
+            {
+                Slice_Map::const_iterator slice = slices.find (id);
+
+                return slice != slices.end () ? slice->second : nullptr;
+            }
+
+            const std::vector< Atlas_Handle > & get_atlases () const
+            {
+                return atlases;
+            }
+
+        private:
+
+            bool load     ();
+            bool place    (const Free_List & free_list, unsigned width, unsigned height, unsigned & x, unsigned & y) const;
+            void split    (Free_List & free_list, const Free_Rectangle & used) const;
+            void copy     (const Image & image, Page & target) const;
+
+        };
+
+    }
+
+#endif
@@ -57,6 +57,17 @@
                 Size2u size;
             };
 
+            /**
+             * Contadores del trabajo enviado al contexto gráfico durante el último fotograma completo.
+             */
+            struct Statistics
+            {
+                unsigned draw_calls;
+                unsigned vertices;
+                unsigned state_changes;             // Cambios de estado que han llegado al contexto gráfico
+                unsigned skipped_state_changes;     // Cambios de estado evitados por no cambiar nada
+            };
+
         public:
 
             typedef Canvas * (* Factory) (Id id, Graphics_Context::Accessor & context, const Options & options);
@@ -87,6 +98,9 @@
         public:
 
             virtual void reset_state     () { }
+            virtual void set_batching    (bool enabled) { }
+
+            virtual Statistics get_statistics () const { return { 0, 0, 0, 0 }; }
 
         public:
 
@@ -108,6 +122,7 @@
             virtual void draw_segment    (const Point2f & a, const Point2f & b) { }
             virtual void draw_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) { }
             virtual void fill_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) { }
+            virtual void fill_strip      (const Point2f * vertices, unsigned count) { }
             virtual void draw_rectangle  (const Point2f & bottom_left, const Size2f & size) { }
             virtual void fill_rectangle  (const Point2f & bottom_left, const Size2f & size) { }
             virtual void fill_rectangle  (const Point2f & where, const Size2f & size, const Texture_2D   * texture, int handling = CENTER) { }
@@ -13,6 +13,9 @@
 #ifndef BASICS_EVENT_QUEUE_HEADER
 #define BASICS_EVENT_QUEUE_HEADER
 
+    #include <chrono>
+    #include <condition_variable>
+    #include <cstdint>
     #include <queue>
     #include <mutex>
     #include <basics/Event>
@@ -20,6 +23,51 @@
     namespace basics
     {
 
+        /**
+         * Counts the events pushed to any Event_Queue so that a thread can sleep until one arrives.
+         * The count is read before polling the queues and passed to wait(), so that an event pushed
+         * in between is not missed.
+         */
+        class Event_Signal
+        {
+
+            std::mutex              mutex;
+            std::condition_variable condition;
+            uint64_t                count = 0;
+
+        public:
+
+            uint64_t get_count ()
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                return count;
+            }
+
+            void notify ()
+            {
+                {
+                    std::lock_guard< std::mutex > lock(mutex);
+
+                    count++;
+                }
+
+                condition.notify_all ();
+            }
+
+            /**
+             * Blocks until an event is pushed after get_count() returned 'seen' or until the timeout.
+             * @return false if it timed out.
+             */
+            bool wait (uint64_t seen, std::chrono::milliseconds timeout)
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+
+                return condition.wait_for (lock, timeout, [&] { return count != seen; });
+            }
+
+        };
+
         class Event_Queue
         {
 
@@ -28,6 +76,14 @@
 
         public:
 
+            // Signal notified by every queue when an event is pushed.
+            static Event_Signal & get_signal ()
+            {
+                static Event_Signal signal;
+
+                return signal;
+            }
+
             void clear ()
             {
                 std::queue< Event >().swap (queue);
@@ -35,16 +91,24 @@
 
             void push (const Event & event)
             {
-                std::lock_guard< std::mutex > lock(mutex);
+                {
+                    std::lock_guard< std::mutex > lock(mutex);
+
+                    queue.push (event);
+                }
 
-                queue.push (event);
+                get_signal ().notify ();
             }
 
             void push (Event && event)
             {
-                std::lock_guard< std::mutex > lock(mutex);
+                {
+                    std::lock_guard< std::mutex > lock(mutex);
+
+                    queue.push (event);
+                }
 
-                queue.push (event);
+                get_signal ().notify ();
             }
 
             bool poll (Event & event)
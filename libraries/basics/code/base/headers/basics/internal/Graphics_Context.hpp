@@ -24,6 +24,7 @@
     #include <basics/Graphics_Resource_Cache>
     #include <basics/Id>
     #include <basics/Point>
+    #include <basics/Renderer>
     #include <basics/Size>
     #include <basics/types>
 
@@ -202,6 +203,18 @@
                 }
             }
 
+            /**
+             * Vacía el trabajo pendiente de todos los renderers. Las especializaciones deben llamarlo
+             * desde flush_and_display() antes de presentar el fotograma.
+             */
+            void flush_renderers ()
+            {
+                for (auto & renderer : renderers)
+                {
+                    renderer.second->flush ();
+                }
+            }
+
             virtual void invalidate () = 0;
             virtual void suspend () = 0;
             virtual bool resume () = 0;
@@ -0,0 +1,141 @@
+/*
+ * RANDOM
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_RANDOM_HEADER
+#define BASICS_RANDOM_HEADER
+
+    #include <cstdint>
+
+    namespace basics
+    {
+
+        /**
+         * Generador de números pseudoaleatorios PCG32 (www.pcg-random.org). A diferencia de rand(),
+         * cada instancia tiene su propio estado, por lo que varias escenas o simulaciones pueden
+         * usar generadores independientes a la vez desde distintos hilos. Con la misma semilla se
+         * obtiene siempre la misma secuencia en cualquier dispositivo, y el estado se puede guardar
+         * y restaurar para repetir una partida exactamente igual.
+         */
+        class Random
+        {
+        public:
+
+            /**
+             * Estado completo del generador. Es un tipo POD que se puede copiar o guardar tal cual.
+             */
+            struct State
+            {
+                uint64_t state;
+                uint64_t increment;             ///< Selecciona la secuencia. Siempre es impar.
+            };
+
+        private:
+
+            State current;
+
+        public:
+
+            /**
+             * Inicializa el generador con una semilla y, opcionalmente, una secuencia. Generadores con
+             * la misma semilla pero distinta secuencia producen valores independientes entre sí.
+             */
+            explicit Random(uint64_t seed = 0x853c49e6748fea9bull, uint64_t sequence = 0xda3e39cb94b95bdbull)
+            {
+                set_seed (seed, sequence);
+            }
+
+            void set_seed (uint64_t seed, uint64_t sequence = 0xda3e39cb94b95bdbull)
+            {
+                current.state     = 0u;
+                current.increment = (sequence << 1u) | 1u;
+
+                next ();
+
+                current.state += seed;
+
+                next ();
+            }
+
+            const State & get_state () const
+            {
+                return current;
+            }
+
+            void set_state (const State & state)
+            {
+                current = state;
+            }
+
+        public:
+
+            /**
+             * Retorna el siguiente número de la secuencia (32 bits uniformemente distribuidos).
+             */
+            uint32_t next ()
+            {
+                uint64_t previous = current.state;
+
+                current.state = previous * 6364136223846793005ull + current.increment;
+
+                uint32_t xorshifted = uint32_t(((previous >> 18u) ^ previous) >> 27u);
+                uint32_t rotation   = uint32_t(previous >> 59u);
+
+                return (xorshifted >> rotation) | (xorshifted << ((32u - rotation) & 31u));
+            }
+
+            /**
+             * Retorna un número entero en el rango [0, bound) sin el sesgo que introduce usar el
+             * operador % directamente. Si bound es 0 retorna 0.
+             */
+            uint32_t next (uint32_t bound)
+            {
+                if (bound == 0) return 0;
+
+                // Se descartan los valores más bajos que harían que unos restos salieran más que otros:
+
+                uint32_t threshold = uint32_t(-bound) % bound;
+
+                for (;;)
+                {
+                    uint32_t value = next ();
+
+                    if (value >= threshold) return value % bound;
+                }
+            }
+
+            /**
+             * Retorna un número entero en el rango [min, max].
+             */
+            int between (int min, int max)
+            {
+                return min + int(next (uint32_t(max - min) + 1u));
+            }
+
+            /**
+             * Retorna un número real en el rango [0, 1).
+             */
+            float next_float ()
+            {
+                return float(next () >> 8) * (1.f / 16777216.f);
+            }
+
+            /**
+             * Retorna un número real en el rango [min, max).
+             */
+            float between (float min, float max)
+            {
+                return min + (max - min) * next_float ();
+            }
+
+        };
+
+    }
+
+#endif
@@ -24,6 +24,14 @@
             Renderer() = default;
             virtual ~Renderer() = default;
 
+        public:
+
+            /**
+             * Se invoca al terminar cada fotograma, justo antes de presentarlo, para que el renderer
+             * envíe al contexto gráfico cualquier trabajo que tenga acumulado.
+             */
+            virtual void flush () { }
+
         };
 
     }
@@ -59,15 +59,17 @@
 
         protected:
 
+            Id    backend;
             float width;
             float height;
 
         protected:
 
-            Texture_2D(unsigned width, unsigned height)
+            Texture_2D(Id backend, unsigned width, unsigned height)
             :
-                width (float(width )),
-                height(float(height))
+                backend(backend),
+                width  (float(width )),
+                height (float(height))
             {
             }
 
@@ -77,6 +79,15 @@
 
         public:
 
+            /**
+             * Identifica el backend gráfico que creó la textura. Los renderers lo comprueban antes de
+             * convertir la textura a su propio tipo con static_cast (en lugar de usar dynamic_cast).
+             */
+            Id get_backend () const
+            {
+                return backend;
+            }
+
             float get_width () const
             {
                 return width;
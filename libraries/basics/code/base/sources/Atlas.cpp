@@ -13,6 +13,7 @@
 #include <basics/assert>
 #include <basics/Asset>
 #include <basics/Atlas>
+#include <algorithm>
 #include <cstring>
 
 #include <basics/Log>
@@ -23,6 +24,8 @@ using namespace rapidxml;
 namespace basics
 {
 
+    constexpr uint32_t Atlas::table_version;
+
     Atlas::Atlas(const string & path, Graphics_Context::Accessor & context)
     {
         shared_ptr< Asset > slices_file = Asset::open (path);
@@ -33,7 +36,14 @@ namespace basics
 
             if (slices_file->read_all (slices_data))
             {
-                parse (slices_data, path, context);
+                // Si el archivo empieza con la cabecera de una tabla binaria no hay que parsear nada:
+
+                if (slices_data.size () >= sizeof(Table_Header) && std::memcmp (slices_data.data (), "ATLS", 4) == 0)
+                {
+                    load_table (slices_data, path, context);
+                }
+                else
+                    parse (slices_data, path, context);
             }
         }
     }
@@ -50,6 +60,9 @@ namespace basics
 
     Atlas::Slice * Atlas::add_slice (Id id, const Point2f & position, const Size2f & size)
     {
+        float texture_width  = texture ? texture->get_width  () : 1.f;
+        float texture_height = texture ? texture->get_height () : 1.f;
+
         if (slices.count (id) == 0)
         {
             return &
@@ -59,7 +72,11 @@ namespace basics
                     this,
                     position.coordinates.x (), position.coordinates.x () + size.width,
                     position.coordinates.y (), position.coordinates.y () + size.height,
-                    size.width,                size.height
+                    size.width,                size.height,
+                    position.coordinates.x ()                / texture_width,
+                   (position.coordinates.x () + size.width ) / texture_width,
+                    position.coordinates.y ()                / texture_height,
+                   (position.coordinates.y () + size.height) / texture_height
                 }
             );
         };
@@ -69,6 +86,111 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
+    const Atlas::Slice * Atlas::find_in_table (Id id) const
+    {
+        Slice_Table::const_iterator entry = std::lower_bound
+        (
+            table.begin (), table.end (), id,
+            [] (const Table_Entry & entry, Id id) { return entry.id < id; }
+        );
+
+        return entry != table.end () && entry->id == id ? &entry->slice : nullptr;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Atlas::load_table (Buffer & table_data, const std::string & path, Graphics_Context::Accessor & context)
+    {
+        Table_Header header;
+
+        std::memcpy (&header, table_data.data (), sizeof(header));
+
+        size_t records_offset = sizeof(header) + header.texture_name_size;
+        size_t expected_size  = records_offset + header.slice_count * sizeof(Table_Record);
+
+        if (header.version != table_version || header.texture_name_size == 0 || table_data.size () != expected_size)
+        {
+            assert(false);
+            return false;
+        }
+
+        const char * texture_name = reinterpret_cast< const char * >(table_data.data () + sizeof(header));
+
+        if (texture_name[header.texture_name_size - 1] != 0) return false;
+
+        load_texture (texture_name, path, context);
+
+        if (!texture) return false;
+
+        // Los registros ya están ordenados por id, así que se copian tal cual a la tabla, que se
+        // reserva de una vez:
+
+        const byte * records = table_data.data () + records_offset;
+
+        table.resize (header.slice_count);
+
+        for (uint32_t index = 0; index < header.slice_count; ++index)
+        {
+            Table_Record record;
+
+            std::memcpy (&record, records + index * sizeof(Table_Record), sizeof(Table_Record));
+
+            table[index] =
+            {
+                record.id,
+                {
+                    this,
+                    record.left,         record.right,         record.bottom,         record.top,
+                    record.width,        record.height,
+                    record.texture_left, record.texture_right, record.texture_bottom, record.texture_top
+                }
+            };
+
+            assert(index == 0 || table[index - 1].id < record.id);
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas::load_texture (const std::string & name, const std::string & path, Graphics_Context::Accessor & context)
+    {
+        // Se determina la ruta de la textura, que es relativa a la carpeta del archivo de slices:
+
+        size_t slash     = path.find_last_of ('/' );
+        size_t backslash = path.find_last_of ('\\');
+        string texture_path;
+
+        if (slash != string::npos && backslash != string::npos)
+        {
+            texture_path = path.substr (0, std::max (slash, backslash + 1));
+        }
+        else
+        if (slash != string::npos)
+        {
+            texture_path = path.substr (0, slash + 1);
+        }
+        else
+        if (backslash != string::npos)
+        {
+            texture_path = path.substr (0, backslash + 1);
+        }
+
+        // Se intenta cargar la textura:
+
+        texture = Texture_2D::create (0, context, texture_path + name);
+
+        assert(texture);
+
+        if (texture)
+        {
+            context->add (texture);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     void Atlas::parse (Buffer & slices_data, const std::string & path, Graphics_Context::Accessor & context)
     {
         // Se pone un caracter nulo al final para que el parseador de rapidxml sepa dónde está el
@@ -102,37 +224,10 @@ namespace basics
 
         if (name_attribute)
         {
-            // Se determina la ruta de la textura:
-
-            size_t slash     = path.find_last_of ('/' );
-            size_t backslash = path.find_last_of ('\\');
-            string texture_path;
-
-            if (slash != string::npos && backslash != string::npos)
-            {
-                texture_path = path.substr (0, std::max (slash, backslash + 1));
-            }
-            else
-            if (slash != string::npos)
-            {
-                texture_path = path.substr (0, slash + 1);
-            }
-            else
-            if (backslash != string::npos)
-            {
-                texture_path = path.substr (0, backslash + 1);
-            }
-
-            // Se intenta cargar la textura:
-
-            texture = Texture_2D::create (0, context, texture_path + name_attribute->value ());
-
-            assert(texture);
+            load_texture (name_attribute->value (), path, context);
 
             if (texture)
             {
-                context->add (texture);
-
                 // Se comprueba que las dimensiones de la textura coinciden con lo que indica el XML:
 
                 //xml_attribute<> * w_attribute = img_tag->first_attribute ("w");
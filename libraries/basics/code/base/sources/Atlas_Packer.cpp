@@ -0,0 +1,325 @@
+/*
+ * ATLAS PACKER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802151045
+ */
+
+#include <algorithm>
+#include <basics/Asset>
+#include <basics/Atlas_Packer>
+#include <basics/Log>
+#include <basics/png_decode>
+#include <basics/Texture_2D>
+
+using namespace std;
+
+namespace basics
+{
+
+    const Atlas_Packer::Options Atlas_Packer::default_options =
+    {
+        2048, 2048,                                 // max_width, max_height
+        1                                           // padding
+    };
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Atlas_Packer::pack (Graphics_Context::Accessor & context)
+    {
+        atlases.clear ();
+        slices .clear ();
+
+        vector< Page      > pages;
+        vector< Placement > placements;
+
+        if (!pack (pages, placements)) return false;
+
+        for (Page & page : pages)
+        {
+            shared_ptr< Texture_2D > texture = Texture_2D::create (0, context, page, { page.get_width (), page.get_height () });
+
+            if (!texture) return false;
+
+            context->add (texture);
+
+            atlases.push_back (Atlas_Handle(new Atlas(texture)));
+        }
+
+        for (const Placement & placement : placements)
+        {
+            slices[placement.id] = atlases[placement.page]->add_slice
+            (
+                placement.id,
+                { float(placement.x),     float(placement.y)      },
+                { float(placement.width), float(placement.height) }
+            );
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Atlas_Packer::pack (vector< Page > & pages, vector< Placement > & placements)
+    {
+        pages     .clear ();
+        placements.clear ();
+
+        if (!load ()) return false;
+
+        // Se colocan primero las imágenes más altas, que son las que dejan los huecos más grandes:
+
+        vector< Image * > order;
+
+        unsigned widest  = 0;
+        unsigned tallest = 0;
+        unsigned area    = 0;
+
+        for (Image & image : images)
+        {
+            unsigned width  = image.pixels.get_width  () + options.padding * 2;
+            unsigned height = image.pixels.get_height () + options.padding * 2;
+
+            widest  = std::max (widest,  width );
+            tallest = std::max (tallest, height);
+            area   += width * height;
+
+            order.push_back (&image);
+        }
+
+        if (widest > options.max_width || tallest > options.max_height)
+        {
+            basics::log.e ("atlas packer: an image is larger than the maximum atlas size");
+            return false;
+        }
+
+        stable_sort
+        (
+            order.begin (), order.end (),
+            [] (const Image * a, const Image * b)
+            {
+                return a->pixels.get_height () != b->pixels.get_height ()
+                     ? a->pixels.get_height ()  > b->pixels.get_height ()
+                     : a->pixels.get_width  ()  > b->pixels.get_width  ();
+            }
+        );
+
+        // El ancho del atlas es la potencia de dos más pequeña en la que caben en total las imágenes
+        // y la más ancha. El alto será el que acaben ocupando:
+
+        unsigned atlas_width = 64;
+
+        while (atlas_width * atlas_width < area || atlas_width < widest) atlas_width *= 2;
+
+        atlas_width = std::min (atlas_width, options.max_width);
+
+        const Free_Rectangle empty_atlas{ 0, 0, atlas_width, options.max_height };
+
+        vector< unsigned > atlas_heights(1, 0);
+        Free_List          free_list{ empty_atlas };
+
+        for (Image * image : order)
+        {
+            unsigned width  = image->pixels.get_width  () + options.padding * 2;
+            unsigned height = image->pixels.get_height () + options.padding * 2;
+            unsigned x = 0, y = 0;
+
+            if (!place (free_list, width, height, x, y))
+            {
+                // No cabe en el atlas actual, por lo que se empieza otro:
+
+                free_list = Free_List{ empty_atlas };
+
+                atlas_heights.push_back (0);
+
+                // En un atlas vacío siempre cabe porque ya se ha comprobado su tamaño, pero por si acaso:
+
+                if (!place (free_list, width, height, x, y))
+                {
+                    basics::log.e ("atlas packer: an image doesn't fit in an empty atlas");
+                    return false;
+                }
+            }
+
+            split (free_list, { x, y, width, height });
+
+            image->atlas = unsigned(atlas_heights.size () - 1);
+            image->x     = x + options.padding;
+            image->y     = y + options.padding;
+
+            atlas_heights.back () = std::max (atlas_heights.back (), y + height);
+        }
+
+        // Se copian las imágenes en las páginas:
+
+        pages.resize (atlas_heights.size ());
+
+        for (unsigned index = 0; index < atlas_heights.size (); ++index)
+        {
+            pages[index].resize (atlas_width, atlas_heights[index]);
+        }
+
+        for (const Image & image : images)
+        {
+            copy (image, pages[image.atlas]);
+
+            placements.push_back ({ image.id, image.atlas, image.x, image.y, image.pixels.get_width (), image.pixels.get_height () });
+        }
+
+        // Las imágenes ya están copiadas en las páginas:
+
+        images.clear ();
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Atlas_Packer::load ()
+    {
+        for (Image & image : images)
+        {
+            shared_ptr< Asset > asset = Asset::open (image.path);
+
+            vector< byte > data;
+            unsigned       width, height;
+
+            if (!asset || !asset->read_all (data) || !png_decode (data, image.pixels, width, height))
+            {
+                basics::log.e ("atlas packer: can't load " + image.path);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Atlas_Packer::place (const Free_List & free_list, unsigned width, unsigned height, unsigned & x, unsigned & y) const
+    {
+        // Se busca el rectángulo libre en el que la imagen cabe y su borde inferior queda más arriba
+        // y, en caso de empate, el que está más a la izquierda:
+
+        unsigned best_bottom = ~0u;
+
+        x = y = 0;
+
+        for (const Free_Rectangle & free : free_list)
+        {
+            if (width <= free.width && height <= free.height)
+            {
+                unsigned bottom = free.y + height;
+
+                if (bottom < best_bottom || (bottom == best_bottom && free.x < x))
+                {
+                    best_bottom = bottom;
+                    x           = free.x;
+                    y           = free.y;
+                }
+            }
+        }
+
+        return best_bottom != ~0u;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas_Packer::split (Free_List & free_list, const Free_Rectangle & used) const
+    {
+        // Cada rectángulo libre que se solapa con la imagen se sustituye por las partes que quedan a
+        // su izquierda, a su derecha, encima y debajo (que pueden solaparse entre sí):
+
+        Free_List split_list;
+
+        for (const Free_Rectangle & free : free_list)
+        {
+            if
+            (
+                used.x >= free.x + free.width  || used.x + used.width  <= free.x ||
+                used.y >= free.y + free.height || used.y + used.height <= free.y
+            )
+            {
+                split_list.push_back (free);
+                continue;
+            }
+
+            if (used.x > free.x)
+            {
+                split_list.push_back ({ free.x, free.y, used.x - free.x, free.height });
+            }
+
+            if (used.x + used.width < free.x + free.width)
+            {
+                split_list.push_back ({ used.x + used.width, free.y, free.x + free.width - used.x - used.width, free.height });
+            }
+
+            if (used.y > free.y)
+            {
+                split_list.push_back ({ free.x, free.y, free.width, used.y - free.y });
+            }
+
+            if (used.y + used.height < free.y + free.height)
+            {
+                split_list.push_back ({ free.x, used.y + used.height, free.width, free.y + free.height - used.y - used.height });
+            }
+        }
+
+        // Se descartan los rectángulos que están contenidos en otro:
+
+        free_list.clear ();
+
+        for (size_t index = 0; index < split_list.size (); ++index)
+        {
+            const Free_Rectangle & a = split_list[index];
+
+            bool contained = false;
+
+            for (size_t other = 0; other < split_list.size () && !contained; ++other)
+            {
+                const Free_Rectangle & b = split_list[other];
+
+                contained =
+                    other != index &&
+                    a.x >= b.x && a.y >= b.y && a.x + a.width <= b.x + b.width && a.y + a.height <= b.y + b.height &&
+                    // De dos rectángulos iguales solo se descarta uno:
+                    (a.x != b.x || a.y != b.y || a.width != b.width || a.height != b.height || other < index);
+            }
+
+            if (!contained) free_list.push_back (a);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas_Packer::copy (const Image & image, Page & target) const
+    {
+        // Se copia cada fila de la imagen extendiendo sus píxeles de los bordes izquierdo y derecho
+        // sobre el margen. Las filas del margen superior e inferior repiten la primera y la última:
+
+        int width   = int(image.pixels.get_width  ());
+        int height  = int(image.pixels.get_height ());
+        int padding = int(options.padding);
+
+        for (int row = -padding; row < height + padding; ++row)
+        {
+            int source_row = std::min (std::max (row, 0), height - 1);
+            int target_row = int(image.y) + row;
+
+            const Rgba8888 * source = &image.pixels[unsigned(source_row * width)];
+                  Rgba8888 * target_pixels = &target[unsigned(target_row * int(target.get_width ()) + int(image.x))];
+
+            for (int column = -padding; column < width + padding; ++column)
+            {
+                target_pixels[column] = source[std::min (std::max (column, 0), width - 1)];
+            }
+        }
+    }
+
+}
@@ -13,11 +13,15 @@
 #ifndef BASICS_DIRECTOR_HEADER
 #define BASICS_DIRECTOR_HEADER
 
+    #include <chrono>
     #include <memory>
     #include <basics/declarations>
     #include <basics/Event_Queue>
+    #include <basics/Frame_Statistics>
     #include <basics/Graphics_Context>
     #include <basics/Graphics_Resource_Cache>
+    #include <basics/Input_Replay>
+    #include <basics/Random>
     #include <basics/Window>
 
     namespace basics
@@ -70,6 +74,17 @@
             Graphics_Context_Factory graphics_context_factory;
             Graphics_Resource_Cache  graphics_resource_cache;
 
+            std::chrono::steady_clock::time_point frame_deadline;
+            Frame_Statistics                      frame_statistics;
+
+            float    time_step;
+            unsigned frame_limit;
+
+            uint64_t                          seed;
+            Random                            seeds;            // Hands out a seed per scene (see next_seed())
+            std::unique_ptr< Input_Recorder > recorder;
+            std::unique_ptr< Input_Player   > player;
+
         private:
 
             Director();
@@ -83,6 +98,34 @@
 
             Graphics_Context::Accessor lock_graphics_context ();
 
+        public:
+
+            /**
+             * Makes the clock virtual: when the step is greater than 0, scenes receive exactly that
+             * time in every frame, whatever the real time was, and frames are run back to back
+             * without waiting for the frame rate. Along with a script played with play(), the same
+             * run always produces the same frames (useful to benchmark whole scenes in a desktop
+             * tool). A step of 0 restores the real clock.
+             */
+            void set_time_step (float step)
+            {
+                time_step = step;
+            }
+
+            float get_time_step () const
+            {
+                return time_step;
+            }
+
+            /**
+             * Makes run_scene() return after the given number of frames have been displayed. A limit
+             * of 0 (the default) runs until the scenes stop.
+             */
+            void set_frame_limit (unsigned limit)
+            {
+                frame_limit = limit;
+            }
+
         public:
 
             void run_scene (const std::shared_ptr< Scene > & new_scene);
@@ -90,6 +133,8 @@
             void stop ()
             {
                 kernel.exit = kernel.running;
+
+                Event_Queue::get_signal ().notify ();        // Wakes up the kernel if it is idle
             }
 
             void handle (const Event & event)
@@ -97,10 +142,90 @@
                 event_queue.push (event);
             }
 
+        public:
+
+            /**
+             * Base seed from which next_seed() derives the seeds of the scenes. It is taken from the
+             * clock when the application starts, stored in the log by start_recording() and replaced
+             * by the one stored in the log by play(). Setting it restarts the sequence of next_seed().
+             */
+            uint64_t get_seed () const
+            {
+                return seed;
+            }
+
+            void set_seed (uint64_t new_seed)
+            {
+                seed = new_seed;
+
+                seeds.set_seed (seed);
+            }
+
+            /**
+             * Returns a different seed every time it is called, so that each scene (each game) gets
+             * different random values. As the sequence starts again from the base seed when a
+             * recording starts or is played back, a recording reproduces the same seeds.
+             */
+            uint64_t next_seed ()
+            {
+                uint64_t high = seeds.next ();
+
+                return high << 32 | seeds.next ();
+            }
+
+            /**
+             * Starts recording the time and the events delivered to the scene in every frame, along
+             * with the current seed. The recording should start before the scenes to be replayed are
+             * created, as their state is not recorded. These methods must be called from the thread
+             * that runs the scenes (usually from a scene).
+             */
+            void start_recording ();
+
+            /**
+             * Stops recording and returns the log, that can be passed to play() later (or saved to a
+             * file and played back on another device or in a desktop tool).
+             */
+            Input_Replay::Buffer stop_recording ();
+
+            bool is_recording () const
+            {
+                return bool(recorder);
+            }
+
+            /**
+             * Starts playing back a log created with stop_recording(): from the next frame on, the
+             * scene receives the recorded times and events instead of the real ones, which are
+             * discarded. Playback stops by itself at the end of the log.
+             * @return false if the log is not valid.
+             */
+            bool play (Input_Replay::Buffer log);
+
+            void stop_playing ()
+            {
+                player.reset ();
+            }
+
+            bool is_playing () const
+            {
+                return bool(player);
+            }
+
+        public:
+
+            /**
+             * Durations of the last frames split into phases. Frames over budget are logged as they
+             * happen and a summary is logged each time the application goes to the background.
+             */
+            Frame_Statistics & get_frame_statistics ()
+            {
+                return frame_statistics;
+            }
+
         private:
 
             void run_kernel ();
             bool check_scene ();
+            void wait_for_frame (float frame_duration);
             void reset_viewport (Window::Accessor & window);
 
         };
@@ -0,0 +1,169 @@
+/*
+ * FRAME STATISTICS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1801101530
+ */
+
+#ifndef BASICS_FRAME_STATISTICS_HEADER
+#define BASICS_FRAME_STATISTICS_HEADER
+
+    #include <cstdint>
+
+    namespace basics
+    {
+
+        /**
+         * Durations of the last frames run by the Director, split into the phases of a frame. The
+         * frames are kept in a fixed ring buffer along with a histogram of their total durations, so
+         * recording a frame costs a few additions and a logarithm and never allocates memory, and
+         * the percentiles are read from the histogram without sorting. The buckets of the histogram
+         * grow geometrically, so their precision is relative (5%) both for fast and slow frames.
+         * A frame that takes longer than one and a half frame budgets (so that at least one display
+         * refresh was missed) is a hitch: it is counted and logged with its phase breakdown.
+         */
+        class Frame_Statistics
+        {
+        public:
+
+            enum Phase
+            {
+                EVENTS,                             // Polling the queues and Scene::handle()
+                UPDATE,                             // Scene::update()
+                RENDER,                             // Scene::render()
+                DISPLAY,                            // Graphics_Context::flush_and_display()
+                WAIT,                               // Waiting for the frame rate of the scene
+                PHASE_COUNT
+            };
+
+            static constexpr unsigned capacity     = 512;       // Frames kept (about 8 s at 60 fps)
+            static constexpr float    first_bucket = 1e-6f;     // Upper edge of the first bucket in seconds
+            static constexpr float    bucket_ratio = 1.05f;     // Each bucket is 5% wider than the previous one
+            static constexpr unsigned bucket_count = 256;       // The last bucket holds every frame over about 241 ms
+
+            struct Frame
+            {
+                float phases[PHASE_COUNT];
+                float total;                        // Whole frame, including the time not in any phase
+                bool  hitch;
+            };
+
+            struct Summary
+            {
+                unsigned frames;                    // Frames the summary is made of
+                unsigned hitches;                   // Hitches among them
+                float    mean;
+                float    p50;
+                float    p95;
+                float    p99;
+                float    max;
+            };
+
+        private:
+
+            Frame    frames   [capacity];
+            uint16_t histogram[bucket_count];
+            unsigned next;                          // Position of the ring where the next frame is written
+            unsigned count;                         // Frames in the ring
+            unsigned hitches;                       // Hitches in the ring
+            double   sum;                           // Sum of the totals of the frames in the ring
+
+            float    budget;
+            bool     logging;
+
+            Frame    current;                       // Frame being measured
+
+        public:
+
+            Frame_Statistics()
+            {
+                budget  = 1.f / 60.f;
+                logging = true;
+
+                clear ();
+            }
+
+            void clear ();
+
+            /**
+             * Sets the expected duration of a frame. Frames longer than 1.5 times this are hitches.
+             */
+            void set_budget (float seconds)
+            {
+                budget = seconds > 0.f ? seconds : 1.f / 60.f;
+            }
+
+            float get_budget () const
+            {
+                return budget;
+            }
+
+            void set_logging (bool enabled)
+            {
+                logging = enabled;
+            }
+
+            /**
+             * Adds time to a phase of the frame being measured. Several calls for the same phase are
+             * added up.
+             */
+            void add (Phase phase, float seconds)
+            {
+                current.phases[phase] += seconds;
+            }
+
+            /**
+             * Finishes the frame being measured and starts a new one.
+             * @param total Duration of the whole frame.
+             */
+            void end_frame (float total);
+
+            /**
+             * Forgets the times added to the frame being measured, which won't be displayed.
+             */
+            void discard_frame ()
+            {
+                current = Frame{};
+            }
+
+            unsigned size () const
+            {
+                return count;
+            }
+
+            /**
+             * Returns one of the frames kept, from 0 (the oldest) to size() - 1 (the latest).
+             */
+            const Frame & get_frame (unsigned index) const
+            {
+                return frames[(next + capacity - count + index) % capacity];
+            }
+
+            /**
+             * Computes the mean, the percentiles (interpolated within the buckets of the histogram)
+             * and the maximum duration of the frames kept.
+             */
+            Summary get_summary () const;
+
+            /**
+             * Writes the summary to the log.
+             */
+            void log_summary () const;
+
+        private:
+
+            static unsigned bucket_of  (float seconds);
+            static float    upper_edge (unsigned bucket);
+
+            void log_hitch (const Frame & frame) const;
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,164 @@
+/*
+ *  INPUT REPLAY
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ *
+ *  C1801072242
+ */
+
+#ifndef BASICS_INPUT_REPLAY_HEADER
+#define BASICS_INPUT_REPLAY_HEADER
+
+    #include <cstdint>
+    #include <vector>
+    #include <basics/Event>
+
+    namespace basics
+    {
+
+        /**
+         * Binary log of the frames run by the Director: the time passed to the scene in each frame
+         * and the events delivered to Scene::handle() during it.
+         *
+         * Layout (all the integers are LEB128 varints, signed ones zigzag encoded):
+         *
+         *   header:  "BIRL", version, seed (8 bytes, little endian)
+         *   frame:   tag = (zigzag(time bits - previous time bits) << 2) | FRAME, event count, events
+         *   idle:    tag = (number of frames << 2) | IDLE_RUN
+         *   event:   id << 2, zigzag(priority), property count, properties
+         *   property key << 2 | type, value
+         *
+         * A run of frames without events and with the same time as the previous one (the usual case
+         * when nobody touches the screen) takes a single varint. Times are stored as the difference
+         * between the bits of consecutive floats, so they are replayed exactly. Ids are written in
+         * full the first time (a 0 reference followed by 4 bytes) and then as a reference to their
+         * index + 1 in a dictionary, and float properties as the difference with the last value of
+         * the same key.
+         */
+        class Input_Replay
+        {
+        public:
+
+            typedef std::vector< uint8_t > Buffer;
+
+            static constexpr uint32_t version = 1;
+
+        protected:
+
+            enum Tag           { IDLE_RUN, FRAME };
+            enum Property_Type { VOID_PROPERTY, BOOL_PROPERTY, INT32_PROPERTY, FLOAT_PROPERTY };
+
+            struct Dictionary_Entry
+            {
+                Id       id;
+                uint32_t last_value;                // Bits of the last float value written for this key
+            };
+
+            std::vector< Dictionary_Entry > dictionary;
+
+            uint32_t last_time_bits;
+
+        protected:
+
+            Input_Replay() : last_time_bits(0)
+            {
+            }
+
+            unsigned find_in_dictionary (Id id) const;
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Writes frames into an Input_Replay buffer. Events are added between begin_frame() and
+         * end_frame(); a frame that has not been ended is not part of the buffer.
+         */
+        class Input_Recorder : private Input_Replay
+        {
+
+            Buffer   buffer;
+            Buffer   frame_events;                  // Events of the frame in progress
+            unsigned frame_event_count;
+            uint32_t frame_time_bits;
+            uint64_t idle_run;                      // Frames pending to be written as a single IDLE_RUN
+            bool     frame_open;
+
+        public:
+
+            explicit Input_Recorder(uint64_t seed);
+
+            void begin_frame (float time);
+            void add_event   (const Event & event);
+            void end_frame   ();
+
+            /**
+             * Returns the frames recorded so far (the one in progress, if any, is left out).
+             */
+            Buffer get_buffer ();
+
+        private:
+
+            void flush_idle_run ();
+            void write_id       (Buffer & output, Id id, unsigned type, unsigned & index);
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Reads back the frames written by an Input_Recorder. Each read_frame() must be followed by
+         * read_event() calls until it returns false.
+         */
+        class Input_Player : private Input_Replay
+        {
+
+            Buffer   buffer;
+            size_t   offset;
+            uint64_t seed;
+            uint64_t idle_run;                      // Frames of the current IDLE_RUN not yet read
+            unsigned pending_events;
+            bool     failed;
+
+        public:
+
+            explicit Input_Player(Buffer data);
+
+            /**
+             * Returns false if the buffer doesn't start with a valid header.
+             */
+            bool good () const
+            {
+                return !failed;
+            }
+
+            uint64_t get_seed () const
+            {
+                return seed;
+            }
+
+            /**
+             * Reads the time of the next frame. Returns false at the end of the log or if the data is
+             * malformed.
+             */
+            bool read_frame (float & time);
+
+            /**
+             * Reads the next event of the current frame. Returns false when there are no more.
+             */
+            bool read_event (Event & event);
+
+        private:
+
+            bool read_varint (uint64_t & value);
+            bool read_id     (Id & id, unsigned & type, unsigned & index);
+
+        };
+
+    }
+
+#endif
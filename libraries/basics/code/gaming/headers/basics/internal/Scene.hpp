@@ -24,13 +24,17 @@
         {
         private:
 
-            float frame_duration;
+            float    frame_duration;
+            float    fixed_step;
+            unsigned max_steps;
 
         public:
 
             Scene()
             {
                 frame_duration = -1.f;
+                fixed_step     = -1.f;
+                max_steps      =  5;
             }
 
             virtual ~Scene() = default;
@@ -46,6 +50,13 @@
             virtual void update     (float time) { }
             virtual void render     (Graphics_Context::Accessor & context) { }
 
+            /**
+             * Called instead of render(context) by the Director. When the scene runs with a fixed
+             * time step, alpha is the fraction of a step (in [0, 1)) elapsed since the last update,
+             * so that the scene can interpolate what it draws. Otherwise alpha is always 1.
+             */
+            virtual void render     (Graphics_Context::Accessor & context, float alpha) { render (context); }
+
             virtual Size2u get_view_size () = 0;
 
         public:
@@ -60,6 +71,31 @@
                 return frame_duration;
             }
 
+            /**
+             * Makes the Director call update() with a constant time step of 1/ticks_per_second,
+             * as many times per frame as needed to keep up with the real time, regardless of the
+             * frame rate of the device. At most max_catch_up_steps updates are made per frame;
+             * any time left behind after that is dropped so that slow frames cannot snowball.
+             * Passing ticks_per_second <= 0 restores the variable time step.
+             */
+            bool set_fixed_tick_rate (int ticks_per_second, unsigned max_catch_up_steps = 5)
+            {
+                fixed_step = ticks_per_second > 0 ? 1.f / float(ticks_per_second) : -1.f;
+                max_steps  = max_catch_up_steps > 0 ? max_catch_up_steps : 1;
+
+                return ticks_per_second > 0;
+            }
+
+            float get_fixed_step () const
+            {
+                return fixed_step;
+            }
+
+            unsigned get_max_catch_up_steps () const
+            {
+                return max_steps;
+            }
+
         };
 
     }
@@ -10,14 +10,21 @@
  * C1801072305
  */
 
+#include <chrono>
+#include <cmath>
+#include <thread>
 #include <basics/Application>
+#include <basics/Canvas>
 #include <basics/Director>
 #include <basics/Log>
+#include <basics/macros>
 #include <basics/Scene>
 #include <basics/Timer>
 #include <basics/Window>
-#include <basics/opengles/Canvas_ES2>
-#include <basics/opengles/Context>
+
+#if defined(BASICS_ANDROID_OS)
+    #include <basics/opengles/Context>
+#endif
 
 namespace basics
 {
@@ -29,7 +36,16 @@ namespace basics
     Director::Director()
     {
         kernel.running           = false;
-        graphics_context_factory = opengles::Context::create;
+        time_step                = 0.f;
+        frame_limit              = 0;
+
+        #if defined(BASICS_ANDROID_OS)
+            graphics_context_factory = opengles::Context::create;
+        #else
+            graphics_context_factory = nullptr;     // It must be set by the platform before running a scene
+        #endif
+
+        set_seed (uint64_t(std::chrono::high_resolution_clock::now ().time_since_epoch ().count ()));
     }
 
     // ---------------------------------------------------------------------------------------------
@@ -79,13 +95,19 @@ namespace basics
             Window::create_window (default_window_id);
         }
 
-        float time = 1.f / 60.f;
-        Event event;
+        float    time        = time_step > 0.f ? time_step : 1.f / 60.f;
+        float    accumulator = 0.f;         // Time not yet simulated by scenes with a fixed time step
+        unsigned frames      = 0;           // Frames displayed (only counted when there is a frame limit)
+        Event    event;
+
+        frame_deadline = std::chrono::steady_clock::now ();
 
         do
         {
-            Timer timer;
-            bool  reset_canvas = false;
+            Timer    timer;
+            bool     reset_canvas = false;
+            bool     displayed    = false;
+            uint64_t events_seen  = Event_Queue::get_signal ().get_count ();
 
             // Check if the current scene must be replaced:
 
@@ -117,15 +139,23 @@ namespace basics
 
                     // Initialize the frame time limit:
 
-                    time = current_scene->get_frame_duration ();
+                    float frame_duration = current_scene->get_frame_duration ();
 
-                    if (time <= 0.f) time = 1.f / 60.f;
+                    if (frame_duration <= 0.f) frame_duration = 1.f / 60.f;
 
+                    frame_statistics.set_budget (frame_duration);
+
+                    time = time_step > 0.f ? time_step : frame_duration;
+
+                    accumulator  = 0.f;
                     reset_canvas = true;
                 }
             }
 
+            Timer phase_timer;
+
             bool previously_active = state;
+            bool suspend_requested = false;
 
             while (application.poll (event))
             {
@@ -139,7 +169,8 @@ namespace basics
 
                     case Application::Event_Id::SUSPEND:
                     {
-                        state.active = false;
+                        state.active      = false;
+                        suspend_requested = true;
                         break;
                     }
 
@@ -214,8 +245,8 @@ namespace basics
                     {
                         bool  currently_active = state;
 
-                        if (!previously_active &&  currently_active) current_scene->resume  (); else
-                        if ( previously_active && !currently_active) current_scene->suspend ();
+                        if (!previously_active &&  currently_active) { current_scene->resume  (); accumulator = 0.f; } else
+                        if ( previously_active && !currently_active) { current_scene->suspend (); frame_statistics.log_summary (); }
 
                         if (currently_active)
                         {
@@ -224,7 +255,27 @@ namespace basics
                             float  h_ratio = float(scene_view_size.width ) / surface_width;
                             float  v_ratio = float(scene_view_size.height) / surface_height;
 
-                            while (event_queue.poll (event))
+                            // When a log is being played back the real input is discarded and the scene
+                            // receives the recorded time and events instead:
+
+                            if (player)
+                            {
+                                while (event_queue.poll (event));
+
+                                if (player->read_frame (time))
+                                {
+                                    while (player && player->read_event (event))
+                                    {
+                                        current_scene->handle (event);
+                                    }
+                                }
+                                else
+                                    player.reset ();
+                            }
+
+                            if (recorder) recorder->begin_frame (time);
+
+                            while (!player && event_queue.poll (event))
                             {
                                 switch (event.id)
                                 {
@@ -242,10 +293,44 @@ namespace basics
                                     }
                                 }
 
+                                if (recorder) recorder->add_event (event);
+
                                 current_scene->handle (event);
                             }
 
-                            current_scene->update (time);
+                            frame_statistics.add (Frame_Statistics::EVENTS, phase_timer.get_elapsed_seconds ());
+                            phase_timer.reset ();
+
+                            float step  = current_scene->get_fixed_step ();
+                            float alpha = 1.f;
+
+                            if (step > 0.f)
+                            {
+                                // Fixed time step: the elapsed time is consumed in constant steps and the
+                                // remainder is carried over to the next frame:
+
+                                unsigned steps = 0, max_steps = current_scene->get_max_catch_up_steps ();
+
+                                for (accumulator += time; accumulator >= step && steps < max_steps; ++steps)
+                                {
+                                    current_scene->update (step);
+
+                                    accumulator -= step;
+                                }
+
+                                // If the frame took too long, the steps that could not be made are dropped:
+
+                                if (accumulator >= step) accumulator = std::fmod (accumulator, step);
+
+                                alpha = accumulator / step;
+                            }
+                            else
+                                current_scene->update (time);
+
+                            if (recorder) recorder->end_frame ();
+
+                            frame_statistics.add (Frame_Statistics::UPDATE, phase_timer.get_elapsed_seconds ());
+                            phase_timer.reset ();
 
                             Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
 
@@ -258,16 +343,66 @@ namespace basics
                                     if (canvas) canvas->reset_state ();
                                 }
 
-                                current_scene->render (graphics_context);
+                                current_scene->render (graphics_context, alpha);
+
+                                frame_statistics.add (Frame_Statistics::RENDER, phase_timer.get_elapsed_seconds ());
+                                phase_timer.reset ();
 
                                 graphics_context->flush_and_display ();
+
+                                frame_statistics.add (Frame_Statistics::DISPLAY, phase_timer.get_elapsed_seconds ());
+
+                                displayed = true;
                             }
                         }
                     }
                 }
             }
 
-            time = timer.get_elapsed_seconds ();
+            // By now the current scene has been suspended (now or earlier, if it was already inactive),
+            // so the state it saved can be persisted by the platform:
+
+            if (suspend_requested) application.saved_state_updated ();
+
+            // Scenes that set a frame rate are not run faster than it. While the application is in
+            // the background nothing is run until an event arrives (like RESUME or GOT_FOCUS), and
+            // the time spent waiting is not passed to the scene. With a fixed time step frames are
+            // run back to back, as the scenes don't see the real time anyway:
+
+            if (current_scene && !kernel.exit && !target_scene)
+            {
+                if (!state)
+                {
+                    Event_Queue::get_signal ().wait (events_seen, std::chrono::milliseconds(500));
+
+                    timer.reset ();
+                }
+                else
+                if (time_step <= 0.f)
+                {
+                    phase_timer.reset ();
+
+                    wait_for_frame (current_scene->get_frame_duration ());
+
+                    frame_statistics.add (Frame_Statistics::WAIT, phase_timer.get_elapsed_seconds ());
+                }
+            }
+
+            float elapsed = timer.get_elapsed_seconds ();
+
+            time = time_step > 0.f ? time_step : elapsed;
+
+            // Only the frames that were displayed are measured (not the ones run in the background).
+            // The real duration is measured even when the scenes receive a fixed time step:
+
+            if (displayed)
+            {
+                frame_statistics.end_frame (elapsed);
+
+                if (frame_limit > 0 && ++frames >= frame_limit) kernel.exit = true;
+            }
+            else
+                frame_statistics.discard_frame ();
         }
         while (!kernel.exit && current_scene);
 
@@ -283,6 +418,94 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
+    void Director::wait_for_frame (float frame_duration)
+    {
+        using namespace std::chrono;
+
+        steady_clock::time_point now = steady_clock::now ();
+
+        if (frame_duration <= 0.f)
+        {
+            frame_deadline = now;
+            return;
+        }
+
+        // The deadlines advance in whole frames from the previous one so that the cadence does not
+        // drift. If a frame took longer than that, the cadence starts again from now instead of
+        // running the next frames faster to catch up:
+
+        frame_deadline += duration_cast< steady_clock::duration > (duration< float >(frame_duration));
+
+        if (frame_deadline <= now)
+        {
+            frame_deadline = now;
+            return;
+        }
+
+        // Sleeping may wake up late, so the thread sleeps until shortly before the deadline and
+        // then yields for the last fraction of a millisecond:
+
+        const steady_clock::duration margin = microseconds(500);
+
+        if (frame_deadline - now > margin)
+        {
+            std::this_thread::sleep_until (frame_deadline - margin);
+        }
+
+        while (steady_clock::now () < frame_deadline)
+        {
+            std::this_thread::yield ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::start_recording ()
+    {
+        player.reset ();
+
+        // The playback restarts the sequence of seeds from the base seed too:
+
+        seeds.set_seed (seed);
+
+        recorder.reset (new Input_Recorder(seed));
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Input_Replay::Buffer Director::stop_recording ()
+    {
+        Input_Replay::Buffer log;
+
+        if (recorder)
+        {
+            log = recorder->get_buffer ();
+
+            recorder.reset ();
+        }
+
+        return log;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Director::play (Input_Replay::Buffer log)
+    {
+        std::unique_ptr< Input_Player > new_player(new Input_Player(std::move (log)));
+
+        if (!new_player->good ()) return false;
+
+        recorder.reset ();
+
+        set_seed (new_player->get_seed ());
+
+        player = std::move (new_player);
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     void Director::reset_viewport (Window::Accessor & window)
     {
         Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
@@ -0,0 +1,183 @@
+/*
+ * FRAME STATISTICS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1801101530
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <basics/Frame_Statistics>
+#include <basics/Log>
+
+namespace basics
+{
+
+    constexpr unsigned Frame_Statistics::capacity;
+    constexpr float    Frame_Statistics::first_bucket;
+    constexpr float    Frame_Statistics::bucket_ratio;
+    constexpr unsigned Frame_Statistics::bucket_count;
+
+    // ---------------------------------------------------------------------------------------------
+
+    // Bucket 0 holds the frames up to first_bucket and bucket n > 0 the ones in the interval
+    // (upper_edge (n - 1), upper_edge (n)]:
+
+    unsigned Frame_Statistics::bucket_of (float seconds)
+    {
+        if (!(seconds > first_bucket)) return 0;
+
+        float bucket = std::ceil (std::log (seconds / first_bucket) / std::log (bucket_ratio));
+
+        return bucket < float(bucket_count - 1) ? unsigned(bucket) : bucket_count - 1;
+    }
+
+    float Frame_Statistics::upper_edge (unsigned bucket)
+    {
+        return first_bucket * std::pow (bucket_ratio, float(bucket));
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Statistics::clear ()
+    {
+        for (auto & bucket : histogram) bucket = 0;
+
+        next    = 0;
+        count   = 0;
+        hitches = 0;
+        sum     = 0.0;
+        current = Frame{};
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Statistics::end_frame (float total)
+    {
+        current.total = total;
+        current.hitch = total > budget * 1.5f;
+
+        if (current.hitch && logging) log_hitch (current);
+
+        // When the ring is full the oldest frame is taken out of the histogram before being replaced:
+
+        Frame & slot = frames[next];
+
+        if (count == capacity)
+        {
+            histogram[bucket_of (slot.total)]--;
+
+            sum -= slot.total;
+
+            if (slot.hitch) hitches--;
+        }
+        else
+            count++;
+
+        slot = current;
+
+        histogram[bucket_of (total)]++;
+
+        sum += total;
+
+        if (current.hitch) hitches++;
+
+        next    = (next + 1) % capacity;
+        current = Frame{};
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Frame_Statistics::Summary Frame_Statistics::get_summary () const
+    {
+        Summary summary{};
+
+        if (count == 0) return summary;
+
+        summary.frames  = count;
+        summary.hitches = hitches;
+        summary.mean    = float(sum / count);
+
+        for (unsigned index = 0; index < count; ++index)
+        {
+            if (frames[index].total > summary.max) summary.max = frames[index].total;
+        }
+
+        // Each percentile is interpolated linearly within the bucket where the cumulative count
+        // reaches it and kept between the lower edge of that bucket and the maximum:
+
+        const float fractions  [] = { .50f, .95f, .99f };
+        float     * percentiles[] = { &summary.p50, &summary.p95, &summary.p99 };
+
+        unsigned accumulated = 0, bucket = 0;
+
+        for (unsigned index = 0; index < 3; ++index)
+        {
+            unsigned target = unsigned(fractions[index] * count + .5f);
+
+            if (target == 0) target = 1;
+
+            while (accumulated + histogram[bucket] < target && bucket < bucket_count - 1)
+            {
+                accumulated += histogram[bucket++];
+            }
+
+            // The last bucket has no upper edge, so the maximum is used instead:
+
+            float lower    = bucket > 0 ? upper_edge (bucket - 1) : 0.f;
+            float upper    = bucket < bucket_count - 1 ? upper_edge (bucket) : summary.max;
+            float fraction = histogram[bucket] > 0 ? float(target - accumulated) / histogram[bucket] : 1.f;
+
+            *percentiles[index] = std::min (std::max (lower + (upper - lower) * fraction, lower), summary.max);
+        }
+
+        return summary;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Statistics::log_summary () const
+    {
+        Summary summary = get_summary ();
+        char    message[160];
+
+        std::snprintf
+        (
+            message, sizeof(message),
+            "frames: %u, mean %.2f ms, p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms, %u hitches",
+            summary.frames, summary.mean * 1e3f, summary.p50 * 1e3f, summary.p95 * 1e3f, summary.p99 * 1e3f, summary.max * 1e3f, summary.hitches
+        );
+
+        log.i (message);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Statistics::log_hitch (const Frame & frame) const
+    {
+        // The message is formatted on the stack so that logging a hitch does not allocate either:
+
+        char message[192];
+
+        std::snprintf
+        (
+            message, sizeof(message),
+            "hitch: %.2f ms (budget %.2f ms) = events %.2f + update %.2f + render %.2f + display %.2f + wait %.2f ms",
+            frame.total * 1e3f, budget * 1e3f,
+            frame.phases[EVENTS ] * 1e3f,
+            frame.phases[UPDATE ] * 1e3f,
+            frame.phases[RENDER ] * 1e3f,
+            frame.phases[DISPLAY] * 1e3f,
+            frame.phases[WAIT   ] * 1e3f
+        );
+
+        log.w (message);
+    }
+
+}
@@ -0,0 +1,391 @@
+/*
+ * INPUT REPLAY
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1801072305
+ */
+
+#include <cstring>
+#include <utility>
+#include <basics/Input_Replay>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        const uint8_t magic[4] = { 'B', 'I', 'R', 'L' };
+
+        inline uint64_t zigzag (int64_t value)
+        {
+            return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+        }
+
+        inline int64_t unzigzag (uint64_t value)
+        {
+            return int64_t(value >> 1) ^ -int64_t(value & 1);
+        }
+
+        inline uint32_t float_bits (float value)
+        {
+            uint32_t bits;
+            std::memcpy (&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        inline float bits_float (uint32_t bits)
+        {
+            float value;
+            std::memcpy (&value, &bits, sizeof(value));
+            return value;
+        }
+
+        void write_varint (Input_Replay::Buffer & output, uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                output.push_back (uint8_t(value) | 0x80);
+                value >>= 7;
+            }
+
+            output.push_back (uint8_t(value));
+        }
+
+        void write_bytes (Input_Replay::Buffer & output, uint64_t value, unsigned count)
+        {
+            for (unsigned index = 0; index < count; ++index, value >>= 8)
+            {
+                output.push_back (uint8_t(value));
+            }
+        }
+
+    }
+
+    constexpr uint32_t Input_Replay::version;
+
+    // ---------------------------------------------------------------------------------------------
+
+    unsigned Input_Replay::find_in_dictionary (Id id) const
+    {
+        // There are only a handful of distinct ids (event types and property names):
+
+        for (unsigned index = 0, size = unsigned(dictionary.size ()); index < size; ++index)
+        {
+            if (dictionary[index].id == id) return index;
+        }
+
+        return unsigned(dictionary.size ());
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Input_Recorder::Input_Recorder(uint64_t seed)
+    {
+        frame_event_count = 0;
+        frame_time_bits   = 0;
+        idle_run          = 0;
+        frame_open        = false;
+
+        buffer.assign (magic, magic + sizeof(magic));
+
+        write_varint (buffer, version);
+        write_bytes  (buffer, seed, 8);
+    }
+
+    void Input_Recorder::begin_frame (float time)
+    {
+        frame_events.clear ();
+
+        frame_event_count = 0;
+        frame_time_bits   = float_bits (time);
+        frame_open        = true;
+    }
+
+    void Input_Recorder::add_event (const Event & event)
+    {
+        // Events that arrive while no frame is open (if recording started in the middle of a frame)
+        // are not recorded, as that frame won't be either:
+
+        if (!frame_open) return;
+
+        unsigned index;
+
+        write_id     (frame_events, event.id, 0, index);
+        write_varint (frame_events, zigzag (event.priority));
+        write_varint (frame_events, event.properties.size ());
+
+        for (auto & property : event.properties)
+        {
+            // The Var getters aren't const, but reading the value doesn't change it:
+
+            Var & value = const_cast< Var & >(property.second);
+
+            unsigned type;
+
+            if (value.is< var::Bool  > ()) type =  BOOL_PROPERTY; else
+            if (value.is< var::Int32 > ()) type = INT32_PROPERTY; else
+            if (value.is< var::Float > ()) type = FLOAT_PROPERTY; else
+                                           type =  VOID_PROPERTY;
+
+            write_id (frame_events, property.first, type, index);
+
+            switch (type)
+            {
+                case BOOL_PROPERTY:
+                {
+                    frame_events.push_back (*value.as< var::Bool > () ? 1 : 0);
+                    break;
+                }
+
+                case INT32_PROPERTY:
+                {
+                    write_varint (frame_events, zigzag (*value.as< var::Int32 > ()));
+                    break;
+                }
+
+                case FLOAT_PROPERTY:
+                {
+                    uint32_t   bits = float_bits (*value.as< var::Float > ());
+                    uint32_t & last = dictionary[index].last_value;
+
+                    write_varint (frame_events, zigzag (int64_t(bits) - int64_t(last)));
+
+                    last = bits;
+                    break;
+                }
+            }
+        }
+
+        frame_event_count++;
+    }
+
+    void Input_Recorder::end_frame ()
+    {
+        if (!frame_open) return;
+
+        frame_open = false;
+
+        if (frame_event_count == 0 && frame_time_bits == last_time_bits)
+        {
+            idle_run++;
+            return;
+        }
+
+        flush_idle_run ();
+
+        write_varint (buffer, (zigzag (int64_t(frame_time_bits) - int64_t(last_time_bits)) << 2) | FRAME);
+        write_varint (buffer, frame_event_count);
+
+        buffer.insert (buffer.end (), frame_events.begin (), frame_events.end ());
+
+        last_time_bits = frame_time_bits;
+    }
+
+    Input_Replay::Buffer Input_Recorder::get_buffer ()
+    {
+        flush_idle_run ();
+
+        return buffer;
+    }
+
+    void Input_Recorder::flush_idle_run ()
+    {
+        if (idle_run > 0)
+        {
+            write_varint (buffer, (idle_run << 2) | IDLE_RUN);
+
+            idle_run = 0;
+        }
+    }
+
+    void Input_Recorder::write_id (Buffer & output, Id id, unsigned type, unsigned & index)
+    {
+        index = find_in_dictionary (id);
+
+        if (index < dictionary.size ())
+        {
+            write_varint (output, (uint64_t(index + 1) << 2) | type);
+        }
+        else
+        {
+            dictionary.push_back ({ id, 0 });
+
+            write_varint (output, type);
+            write_bytes  (output, id, 4);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Input_Player::Input_Player(Buffer data) : buffer(std::move (data))
+    {
+        offset         = sizeof(magic);
+        seed           = 0;
+        idle_run       = 0;
+        pending_events = 0;
+
+        uint64_t file_version;
+
+        failed = buffer.size () < sizeof(magic) || std::memcmp (buffer.data (), magic, sizeof(magic)) != 0
+              || !read_varint (file_version) || file_version != version || buffer.size () - offset < 8;
+
+        if (!failed)
+        {
+            for (unsigned index = 0; index < 8; ++index)
+            {
+                seed |= uint64_t(buffer[offset++]) << (8 * index);
+            }
+        }
+    }
+
+    bool Input_Player::read_frame (float & time)
+    {
+        // Events of the previous frame that were not read are skipped:
+
+        Event skipped;
+
+        while (pending_events > 0 && read_event (skipped));
+
+        if (failed) return false;
+
+        if (idle_run == 0)
+        {
+            uint64_t tag, count;
+
+            if (offset == buffer.size () || !read_varint (tag)) return false;
+
+            if ((tag & 3) == IDLE_RUN && tag >> 2 != 0)
+            {
+                idle_run = tag >> 2;
+            }
+            else if ((tag & 3) == FRAME && read_varint (count))
+            {
+                last_time_bits = uint32_t(int64_t(last_time_bits) + unzigzag (tag >> 2));
+                pending_events = unsigned(count);
+            }
+            else
+                return failed = true, false;
+        }
+
+        if (idle_run > 0) idle_run--;
+
+        time = bits_float (last_time_bits);
+
+        return true;
+    }
+
+    bool Input_Player::read_event (Event & event)
+    {
+        if (pending_events == 0 || failed) return false;
+
+        pending_events--;
+
+        uint64_t priority, property_count;
+        unsigned type, index;
+
+        if (!read_id (event.id, type, index) || !read_varint (priority) || !read_varint (property_count))
+        {
+            return failed = true, false;
+        }
+
+        event.priority = int(unzigzag (priority));
+        event.properties.clear ();
+
+        for (uint64_t property = 0; property < property_count; ++property)
+        {
+            uint64_t value;
+            unsigned type;
+            Id       key;
+
+            if (!read_id (key, type, index)) return false;
+
+            Var & target = event.properties[key];
+
+            switch (type)
+            {
+                case BOOL_PROPERTY:
+                {
+                    if (offset >= buffer.size ()) return failed = true, false;
+
+                    target = buffer[offset++] != 0;
+                    break;
+                }
+
+                case INT32_PROPERTY:
+                {
+                    if (!read_varint (value)) return failed = true, false;
+
+                    target = int32_t(unzigzag (value));
+                    break;
+                }
+
+                case FLOAT_PROPERTY:
+                {
+                    if (!read_varint (value)) return failed = true, false;
+
+                    uint32_t & last = dictionary[index].last_value;
+
+                    last   = uint32_t(int64_t(last) + unzigzag (value));
+                    target = bits_float (last);
+                    break;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool Input_Player::read_varint (uint64_t & value)
+    {
+        value = 0;
+
+        for (unsigned shift = 0; shift < 64 && offset < buffer.size (); shift += 7)
+        {
+            uint8_t byte = buffer[offset++];
+
+            value |= uint64_t(byte & 0x7F) << shift;
+
+            if ((byte & 0x80) == 0) return true;
+        }
+
+        return failed = true, false;
+    }
+
+    bool Input_Player::read_id (Id & id, unsigned & type, unsigned & index)
+    {
+        uint64_t reference;
+
+        if (!read_varint (reference)) return false;
+
+        type       = unsigned(reference & 3);
+        reference >>= 2;
+
+        if (reference != 0)
+        {
+            if (reference > dictionary.size ()) return failed = true, false;
+
+            index = unsigned(reference - 1);
+            id    = dictionary[index].id;
+        }
+        else
+        {
+            if (buffer.size () - offset < 4) return failed = true, false;
+
+            id = Id(buffer[offset]) | Id(buffer[offset + 1]) << 8 | Id(buffer[offset + 2]) << 16 | Id(buffer[offset + 3]) << 24;
+
+            offset += 4;
+            index   = unsigned(dictionary.size ());
+
+            dictionary.push_back ({ id, 0 });
+        }
+
+        return true;
+    }
+
+}
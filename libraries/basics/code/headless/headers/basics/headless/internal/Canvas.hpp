@@ -0,0 +1,112 @@
+/*
+ * HEADLESS CANVAS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101300
+ */
+
+#ifndef BASICS_HEADLESS_CANVAS_HEADER
+#define BASICS_HEADLESS_CANVAS_HEADER
+
+    #include <cstdint>
+    #include <basics/Canvas>
+
+    namespace basics { namespace headless
+    {
+
+        /**
+         * Canvas that draws nothing and only counts what it is asked to draw. Every primitive counts
+         * as one draw call (as if batching was disabled), so the numbers show how much work the
+         * scenes send to the canvas and not how a particular backend would group it.
+         */
+        class Canvas final : public basics::Canvas
+        {
+        public:
+
+            static basics::Canvas * create (Id id, Graphics_Context::Accessor & context, const Options & options);
+
+            static void enable ()
+            {
+                register_factory (ID(headless), create);
+            }
+
+        public:
+
+            /** Totals since the canvas was created. */
+            struct Totals
+            {
+                unsigned frames;
+                uint64_t draw_calls;
+                uint64_t vertices;
+            };
+
+        private:
+
+            Size2u     size;
+            Statistics current;                 // Work of the frame in progress
+            Statistics last;                    // Work of the last complete frame
+            Totals     totals;
+
+        public:
+
+            Canvas(const Size2u & size) : size(size), current{ 0, 0, 0, 0 }, last{ 0, 0, 0, 0 }, totals{ 0, 0, 0 }
+            {
+            }
+
+        public:
+
+            Statistics get_statistics () const override
+            {
+                return last;
+            }
+
+            const Totals & get_totals () const
+            {
+                return totals;
+            }
+
+            void set_size (const Size2u & new_size) override
+            {
+                size = new_size;
+            }
+
+            void flush () override
+            {
+                last     = current;
+                current  = { 0, 0, 0, 0 };
+
+                totals.frames++;
+            }
+
+        public:
+
+            void draw_point     (const Point2f & ) override                                      { count (1); }
+            void draw_segment   (const Point2f & , const Point2f & ) override                    { count (2); }
+            void draw_triangle  (const Point2f & , const Point2f & , const Point2f & ) override  { count (3); }
+            void fill_triangle  (const Point2f & , const Point2f & , const Point2f & ) override  { count (3); }
+            void fill_strip     (const Point2f * , unsigned vertex_count) override               { count (vertex_count); }
+            void draw_rectangle (const Point2f & , const Size2f & ) override                     { count (4); }
+            void fill_rectangle (const Point2f & , const Size2f & ) override                     { count (4); }
+            void fill_rectangle (const Point2f & , const Size2f & , const Texture_2D   * , int ) override { count (4); }
+            void fill_rectangle (const Point2f & , const Size2f & , const Atlas::Slice * , int ) override { count (4); }
+
+        private:
+
+            void count (unsigned vertices)
+            {
+                current.draw_calls += 1;
+                current.vertices   += vertices;
+                totals .draw_calls += 1;
+                totals .vertices   += vertices;
+            }
+
+        };
+
+    }}
+
+#endif
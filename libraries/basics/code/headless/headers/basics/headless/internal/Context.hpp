@@ -0,0 +1,108 @@
+/*
+ * HEADLESS CONTEXT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101255
+ */
+
+#ifndef BASICS_HEADLESS_CONTEXT_HEADER
+#define BASICS_HEADLESS_CONTEXT_HEADER
+
+    #include <basics/Graphics_Context>
+    #include <basics/Window>
+
+    namespace basics { namespace headless
+    {
+
+        /**
+         * Graphics context that has no surface. Its size is the one of the window and displaying a
+         * frame only flushes the renderers.
+         */
+        class Context final : public basics::Graphics_Context
+        {
+        public:
+
+            static bool create (basics::Window::Accessor & window, Graphics_Resource_Cache * cache);
+
+        private:
+
+            unsigned surface_width;
+            unsigned surface_height;
+            unsigned frames;
+
+        public:
+
+            Context(Window & window, Graphics_Resource_Cache * cache);
+
+           ~Context()
+            {
+                finalize ();
+            }
+
+        public:
+
+            Id get_id () const override
+            {
+                return ID(headless);
+            }
+
+            bool is_available () const override
+            {
+                return true;
+            }
+
+            bool is_current () const override
+            {
+                return true;
+            }
+
+            void invalidate () override { }
+            void suspend    () override { }
+            bool resume     () override { return true; }
+
+            unsigned get_surface_width () override
+            {
+                return surface_width;
+            }
+
+            unsigned get_surface_height () override
+            {
+                return surface_height;
+            }
+
+            bool set_sync_swap  (bool ) override { return true; }
+            void reset_viewport () override;
+            void set_viewport   (const Point2u & , const Size2u & ) override { }
+
+            bool make_current () override
+            {
+                return true;
+            }
+
+            bool flush_and_display () override
+            {
+                flush_renderers ();
+
+                frames++;
+
+                return true;
+            }
+
+        public:
+
+            /** Number of frames displayed since the context was created. */
+            unsigned get_frame_count () const
+            {
+                return frames;
+            }
+
+        };
+
+    }}
+
+#endif
@@ -0,0 +1,42 @@
+/*
+ * HEADLESS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101250
+ */
+
+#ifndef BASICS_HEADLESS_HEADER
+#define BASICS_HEADLESS_HEADER
+
+    #include <string>
+
+    namespace basics
+    {
+
+        /**
+         * Graphics backend that draws nothing. It is enabled with enable< Headless >() and lets the
+         * scenes run in desktop tools and on machines without a display or a GPU.
+         */
+        class Headless;
+
+        namespace headless
+        {
+
+            /**
+             * Directory from which the assets are read (it plays the role of the assets folder of
+             * the APK). By default assets are read from the working directory.
+             */
+            void set_asset_path (const std::string & path);
+
+            const std::string & get_asset_path ();
+
+        }
+
+    }
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * HEADLESS TEXTURE 2D
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101305
+ */
+
+#ifndef BASICS_HEADLESS_TEXTURE_2D_HEADER
+#define BASICS_HEADLESS_TEXTURE_2D_HEADER
+
+    #include <basics/Color_Buffer>
+    #include <basics/Texture_2D>
+
+    namespace basics { namespace headless
+    {
+
+        /**
+         * Texture that only keeps its size (the pixels are decoded to know it and then discarded).
+         */
+        class Texture_2D final : public basics::Texture_2D
+        {
+        public:
+
+            static std::shared_ptr< basics::Texture_2D > create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options = {});
+
+            static void enable ()
+            {
+                register_factory (ID(headless), create);
+            }
+
+        public:
+
+            Texture_2D(unsigned width, unsigned height) : basics::Texture_2D(ID(headless), width, height)
+            {
+            }
+
+        public:
+
+            bool initialize () override
+            {
+                return initialized = true;
+            }
+
+            void finalize () override
+            {
+                initialized = false;
+            }
+
+        };
+
+    }}
+
+#endif
@@ -0,0 +1,27 @@
+/*
+ * HEADLESS CANVAS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101315
+ */
+
+#include <basics/headless/Canvas>
+
+namespace basics { namespace headless
+{
+
+    basics::Canvas * Canvas::create (Id id, Graphics_Context::Accessor & context, const Options & options)
+    {
+        std::shared_ptr< Canvas > canvas(new Canvas(options.size));
+
+        context->add (id, canvas);
+
+        return canvas.get ();
+    }
+
+}}
@@ -0,0 +1,34 @@
+/*
+ * HEADLESS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802101330
+ */
+
+#include <basics/headless/Headless>
+
+namespace basics { namespace headless
+{
+
+    static std::string & asset_path ()
+    {
+        static std::string path;
+        return path;
+    }
+
+    void set_asset_path (const std::string & path)
+    {
+        asset_path () = path;
+    }
+
+    const std::string & get_asset_path ()
+    {
+        return asset_path ();
+    }
+
+}}
@@ -22,6 +22,8 @@
 
 #if defined(BASICS_ANDROID_OS)
 
+    #include <EGL/eglext.h>
+    #include <basics/opengles/GL_State>
     #include <basics/opengles/OpenGL_ES1>
     #include "Android_OpenGL_ES_Context.hpp"
     #include "../../../base/adapters/android/Native_Window.hpp"
@@ -38,8 +40,8 @@
             surface       = EGL_NO_SURFACE;
             context       = EGL_NO_CONTEXT;
             config        = nullptr;
+            version       = VERSION_3_0;            // Se baja a 2.0 si no se puede crear un contexto de la 3.0
             available     = initialized = native_window && initialize_display () && initialize_surface () && initialize_context ();
-            version       = VERSION_2_0;
         }
 
         void Android_OpenGL_ES_Context::suspend ()
@@ -113,6 +115,8 @@
         {
             if (available)
             {
+                flush_renderers ();
+
                 //return eglSwapBuffers (display, surface) == EGL_TRUE;
 
                 if (!eglSwapBuffers (display, surface))
@@ -181,21 +185,15 @@
 
         bool Android_OpenGL_ES_Context::initialize_surface ()
         {
-            const EGLint desired_attributes[] =
-            {
-                EGL_ATTRIBUTE( EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT ),
-                EGL_ATTRIBUTE( EGL_SURFACE_TYPE,    EGL_WINDOW_BIT     ),
-                EGL_ATTRIBUTE( EGL_DEPTH_SIZE,      0                  ),
-                EGL_NONE
-            };
+            // Si no hay configuraciones para OpenGL ES 3 se elige una para OpenGL ES 2 y el contexto se
+            // creará después con esa versión:
 
-            EGLint number_of_suitable_configurations = 0;
+            if (version >= VERSION_3_0 && !choose_config (EGL_OPENGL_ES3_BIT_KHR))
+            {
+                version = VERSION_2_0;
+            }
 
-            if
-            (
-                eglChooseConfig (display, desired_attributes, &config, 1, &number_of_suitable_configurations) &&
-                number_of_suitable_configurations > 0
-            )
+            if (version >= VERSION_3_0 || choose_config (EGL_OPENGL_ES2_BIT))
             {
                 surface = eglCreateWindowSurface (display, config, native_window, nullptr);
 
@@ -211,15 +209,55 @@
             return false;
         }
 
-        bool Android_OpenGL_ES_Context::initialize_context ()
+        bool Android_OpenGL_ES_Context::choose_config (EGLint renderable_type)
         {
-            const EGLint context_attributes[] =
+            const EGLint desired_attributes[] =
             {
-                EGL_ATTRIBUTE( EGL_CONTEXT_CLIENT_VERSION, 2 ),
+                EGL_ATTRIBUTE( EGL_RENDERABLE_TYPE, renderable_type ),
+                EGL_ATTRIBUTE( EGL_SURFACE_TYPE,    EGL_WINDOW_BIT  ),
+                EGL_ATTRIBUTE( EGL_DEPTH_SIZE,      0               ),
                 EGL_NONE
             };
 
-            context = eglCreateContext (display, config, EGL_NO_CONTEXT, context_attributes);
+            EGLint number_of_suitable_configurations = 0;
+
+            return
+                eglChooseConfig (display, desired_attributes, &config, 1, &number_of_suitable_configurations) &&
+                number_of_suitable_configurations > 0;
+        }
+
+        bool Android_OpenGL_ES_Context::initialize_context ()
+        {
+            // Se intenta crear un contexto de OpenGL ES 3.0 (compatible con el código de OpenGL ES 2.0)
+            // y, si el sistema o la configuración elegida no lo permiten, uno de OpenGL ES 2.0:
+
+            if (version >= VERSION_3_0)
+            {
+                const EGLint context_attributes[] =
+                {
+                    EGL_ATTRIBUTE( EGL_CONTEXT_CLIENT_VERSION, 3 ),
+                    EGL_NONE
+                };
+
+                context = eglCreateContext (display, config, EGL_NO_CONTEXT, context_attributes);
+
+                if (context == EGL_NO_CONTEXT) version = VERSION_2_0;
+            }
+
+            if (version < VERSION_3_0)
+            {
+                const EGLint context_attributes[] =
+                {
+                    EGL_ATTRIBUTE( EGL_CONTEXT_CLIENT_VERSION, 2 ),
+                    EGL_NONE
+                };
+
+                context = eglCreateContext (display, config, EGL_NO_CONTEXT, context_attributes);
+            }
+
+            // El estado de un contexto nuevo es el inicial, no el que tuviese el anterior:
+
+            GL_State::invalidate ();
 
             return context != EGL_NO_CONTEXT;
         }
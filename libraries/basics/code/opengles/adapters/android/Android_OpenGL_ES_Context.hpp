@@ -94,6 +94,8 @@
             bool initialize_surface ();
             bool initialize_context ();
 
+            bool choose_config      (EGLint renderable_type);
+
             void finalize_display ();
             void finalize_surface ();
             void finalize_context ();
@@ -14,6 +14,7 @@
 #define BASICS_OPENGLES_CANVAS_ES2_HEADER
 
     #include <memory>
+    #include <vector>
     #include <basics/Canvas>
     #include <basics/Transformation>
 
@@ -21,6 +22,7 @@
     {
 
         class Shader_Program;
+        class Texture_2D;
 
         class Canvas_ES2 : public basics::Canvas
         {
@@ -28,8 +30,22 @@
 
             static const char * internal_vertex_shader_f;
             static const char * internal_vertex_shader_t;
+            static const char * internal_vertex_shader_b;
             static const char * internal_fragment_shader_f;
             static const char * internal_fragment_shader_t;
+            static const char * internal_fragment_shader_b;
+
+            // Número máximo de quads que se acumulan antes de forzar un volcado del lote. Con índices
+            // de 16 bits no puede pasar de 16384 (65536 vértices):
+
+            static constexpr unsigned batch_capacity = 1024;
+
+            struct Batch_Vertex
+            {
+                float x, y;
+                float u, v;
+                float opacity;
+            };
 
         public:
 
@@ -39,10 +55,14 @@
 
             static void enable ()
             {
+                // Los contextos de OpenGL ES 3 también pueden usar este canvas si no se ha registrado
+                // antes Canvas_ES3:
+
                 register_factory (ID(opengles2), Canvas_ES2::create);
+                register_factory (ID(opengles3), Canvas_ES2::create);
             }
 
-        private:
+        protected:
 
             Size2f size;
             Size2f half_size;
@@ -50,6 +70,12 @@
             Transformation2f transform;
             Transformation2f projection;
 
+            bool                         batching;
+            float                        opacity;
+            const Texture_2D           * batch_texture;
+
+        private:
+
             std::shared_ptr< Shader_Program > shader_program_f;
             std::shared_ptr< Shader_Program > shader_program_t;
 
@@ -66,13 +92,38 @@
             unsigned   vertex_position_location_t;
             unsigned vertex_texture_uv_location_t;
 
+            std::shared_ptr< Shader_Program > shader_program_b;
+
+            int  transform_b_id;
+            int projection_b_id;
+            int    sampler_b_id;
+
+            unsigned   vertex_position_location_b;
+            unsigned vertex_texture_uv_location_b;
+            unsigned   vertex_opacity_location_b;
+
+            std::vector< Batch_Vertex >  batch_vertices;
+            unsigned                     batch_vertex_buffer;
+            unsigned                     batch_index_buffer;
+
+            Statistics                   statistics;
+            Statistics                   frame_statistics;
+
         public:
 
             Canvas_ES2(Graphics_Context::Accessor & context, const Size2u & viewport_size);
+           ~Canvas_ES2();
 
         public:
 
             void reset_state     () override;
+            void set_batching    (bool enabled) override;
+            void flush           () override;
+
+            Statistics get_statistics () const override
+            {
+                return frame_statistics;
+            }
 
         public:
 
@@ -83,6 +134,7 @@
             void set_clear_color (float r, float g, float b) override;
             void set_color       (float r, float g, float b) override;
             void set_opacity     (float opacity) override;
+            void set_blending    (Blending blending) override;
             void set_transform   (const Transformation2f & transform) override;
             void apply_transform (const Transformation2f & transform) override;
 
@@ -93,11 +145,27 @@
             void draw_segment    (const Point2f & a, const Point2f & b) override;
             void draw_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
             void fill_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void fill_strip      (const Point2f * vertices, unsigned count) override;
             void draw_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
             void fill_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
             void fill_rectangle  (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling = CENTER) override;
             void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling = CENTER) override;
 
+        protected:
+
+            // Las especializaciones pueden cambiar la forma de agrupar los quads texturizados. Las
+            // coordenadas y las de textura siguen el orden del strip: abajo a la izquierda, arriba a
+            // la izquierda, abajo a la derecha y arriba a la derecha:
+
+            virtual void batch_quad  (const Texture_2D * texture, const Point2f (& coordinates)[4], const Point2f * texture_uvs);
+            virtual void flush_batch ();
+
+            void count_draw_call (unsigned vertex_count)
+            {
+                statistics.draw_calls++;
+                statistics.vertices += vertex_count;
+            }
+
         };
 
     }}
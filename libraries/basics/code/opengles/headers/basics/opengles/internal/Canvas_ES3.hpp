@@ -0,0 +1,98 @@
+/*
+ * CANVAS ES 3
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802261200
+ */
+
+#ifndef BASICS_OPENGLES_CANVAS_ES3_HEADER
+#define BASICS_OPENGLES_CANVAS_ES3_HEADER
+
+    #include <memory>
+    #include <vector>
+    #include <basics/opengles/Canvas_ES2>
+
+    namespace basics { namespace opengles
+    {
+
+        /**
+         * Canvas para contextos de OpenGL ES 3. Dibuja como Canvas_ES2 salvo los quads texturizados
+         * agrupados, que se envían con instancing: cada quad es una instancia que ocupa un registro
+         * (rectángulo, coordenadas de textura y opacidad) en lugar de cuatro vértices, y el estado de
+         * los atributos se guarda en un vertex array object, por lo que cada lote se dibuja con una
+         * sola llamada sin volver a configurarlos. Las funciones de OpenGL ES 3 se obtienen al crear
+         * el canvas (la aplicación puede ejecutarse en sistemas que no las tienen). Si no están
+         * disponibles o no se puede compilar el programa, los lotes se dibujan como en Canvas_ES2.
+         */
+        class Canvas_ES3 : public Canvas_ES2
+        {
+        private:
+
+            static const char * internal_vertex_shader_i;
+            static const char * internal_fragment_shader_i;
+
+            // Sin índices de 16 bits no hay un límite de quads por lote más allá del tamaño del buffer:
+
+            static constexpr unsigned instance_capacity = 4096;
+
+            struct Instance
+            {
+                float left,  bottom;                    // Rectángulo del quad
+                float width, height;
+                float u0, v0;                           // Coordenadas de textura de la esquina inferior izquierda
+                float u1, v1;                           // Coordenadas de textura de la esquina superior derecha
+                float opacity;
+            };
+
+        public:
+
+            static Canvas * create (Id id, Graphics_Context::Accessor & context, const Options & options);
+
+        public:
+
+            static void enable ()
+            {
+                register_factory (ID(opengles3), Canvas_ES3::create);
+            }
+
+        private:
+
+            bool instancing;                            // false si se dibuja como Canvas_ES2
+
+            std::shared_ptr< Shader_Program > shader_program_i;
+
+            int  transform_i_id;
+            int projection_i_id;
+            int    sampler_i_id;
+
+            std::vector< Instance > instances;
+            unsigned                vertex_array;
+            unsigned                corner_buffer;
+            unsigned                instance_buffer;
+
+        public:
+
+            Canvas_ES3(Graphics_Context::Accessor & context, const Size2u & viewport_size);
+           ~Canvas_ES3();
+
+        public:
+
+            void set_size        (const Size2u & size) override;
+            void set_transform   (const Transformation2f & transform) override;
+            void apply_transform (const Transformation2f & transform) override;
+
+        protected:
+
+            void batch_quad      (const Texture_2D * texture, const Point2f (& coordinates)[4], const Point2f * texture_uvs) override;
+            void flush_batch     () override;
+
+        };
+
+    }}
+
+#endif
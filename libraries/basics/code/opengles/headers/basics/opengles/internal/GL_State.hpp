@@ -0,0 +1,111 @@
+/*
+ * GL STATE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802111200
+ */
+
+#ifndef BASICS_OPENGLES_GL_STATE_HEADER
+#define BASICS_OPENGLES_GL_STATE_HEADER
+
+    #include <cstdint>
+    #include <basics/opengles/OpenGL_ES2>
+
+    namespace basics { namespace opengles
+    {
+
+        /**
+         * Copia del estado de OpenGL ES que cambian los renderers (textura ligada, programa en uso,
+         * buffers ligados, atributos de vértice habilitados y mezcla de colores). Los cambios se
+         * hacen a través de esta clase, que solo llama a OpenGL cuando el valor pedido es distinto
+         * del actual. Como el resto del módulo, supone que la aplicación tiene un único contexto.
+         * Cuando se crea o se destruye el contexto (o alguien cambia el estado sin pasar por aquí)
+         * hay que llamar a invalidate() para que el siguiente cambio se haga siempre.
+         */
+        class GL_State
+        {
+        public:
+
+            static constexpr unsigned max_vertex_attributes = 8;        // Mínimo que garantiza OpenGL ES 2.0
+
+            /**
+             * Número de cambios de estado pedidos que han llegado a OpenGL y número de los que se han
+             * evitado por ser redundantes.
+             */
+            struct Counters
+            {
+                unsigned issued;
+                unsigned skipped;
+            };
+
+        private:
+
+            static constexpr GLuint unknown = ~GLuint(0);
+
+            static GLuint   bound_texture;
+            static GLuint   current_program;
+            static GLuint   array_buffer;
+            static GLuint   element_array_buffer;
+            static uint32_t enabled_attributes;         // Un bit por cada atributo habilitado
+            static bool     attributes_known;
+            static int      blending;                   // -1 si se desconoce, 0 deshabilitada, 1 habilitada
+            static GLenum   blend_source;
+            static GLenum   blend_destination;
+            static bool     texture_unit_known;
+
+            static Counters counters;
+
+        public:
+
+            static void invalidate ();
+
+            static void bind_texture   (GLuint texture);
+            static void use_program    (GLuint program);
+            static void bind_buffer    (GLenum target, GLuint buffer);
+
+            /**
+             * Deja habilitados exactamente los atributos cuyo bit está activo en la máscara.
+             */
+            static void set_vertex_attributes (uint32_t mask);
+
+            static void set_blending   (bool enabled, GLenum source = GL_SRC_ALPHA, GLenum destination = GL_ONE_MINUS_SRC_ALPHA);
+
+            /**
+             * Se deben llamar antes de borrar el objeto de OpenGL correspondiente, ya que su nombre se
+             * puede reutilizar para otro objeto.
+             */
+            static void forget_texture (GLuint texture);
+            static void forget_program (GLuint program);
+            static void forget_buffer  (GLuint buffer);
+
+        public:
+
+            static const Counters & get_counters ()
+            {
+                return counters;
+            }
+
+            static void reset_counters ()
+            {
+                counters = { 0, 0 };
+            }
+
+        private:
+
+            static bool issue (bool needed)
+            {
+                if (needed) counters.issued++; else counters.skipped++;
+
+                return needed;
+            }
+
+        };
+
+    }}
+
+#endif
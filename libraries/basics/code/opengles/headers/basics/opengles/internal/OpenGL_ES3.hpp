@@ -18,4 +18,9 @@
 
     // DETERMINAR SI ESTÁN DISPONIBLES LAS CABECERAS DE OPENGL ES 3.1 Y 3.2
 
+    namespace basics
+    {
+        class OpenGL_ES3;
+    }
+
 #endif
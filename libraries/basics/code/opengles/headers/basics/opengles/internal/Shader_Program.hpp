@@ -19,6 +19,7 @@
     #include <basics/Matrix>
     #include <basics/Point>
     #include <basics/Vector>
+    #include <basics/opengles/GL_State>
     #include <basics/opengles/Shader>
 
     namespace basics { namespace opengles
@@ -28,7 +29,31 @@
         {
         private:
 
-            typedef std::map< std::string, GLint > Uniform_Map;
+            /*
+             * Último valor dado a un uniform. Los valores se guardan aquí y no se envían a OpenGL
+             * hasta que se usa el programa (ver use ()), y solo si han cambiado desde el último envío.
+             */
+            struct Uniform
+            {
+                enum Type
+                {
+                    INTEGER,
+                    VECTOR,
+                    MATRIX
+                };
+
+                Type     type;
+                unsigned size;                          // Número de valores que se usan de values.
+                bool     dirty;                         // true si aún no se ha enviado el valor actual.
+
+                union
+                {
+                    GLint integer;
+                    float values[16];
+                };
+            };
+
+            typedef std::map< GLint, Uniform > Uniform_Map;
 
         private:
 
@@ -44,7 +69,9 @@
 
             static void disable ()
             {
-                glUseProgram (0);
+                GL_State::use_program (0);
+
+                active_shader_program = nullptr;
             }
 
         private:
@@ -54,12 +81,15 @@
             unsigned    instance_id;
             GLuint      program_object_id;
             std::string log_string;
+            Uniform_Map uniforms;                       // Valores de los uniforms indexados por su localización.
+            bool        uniforms_dirty;                 // true si algún uniform está pendiente de enviar.
 
         public:
 
             Shader_Program()
             {
-                instance_id = instance_count++;
+                instance_id    = instance_count++;
+                uniforms_dirty = false;
             }
 
             Shader_Program(const Shader_Program & ) = delete;
@@ -77,7 +107,20 @@
             {
                 if (initialized)
                 {
+                    if (active_shader_program == this) active_shader_program = nullptr;
+
+                    GL_State::forget_program (program_object_id);
+
                     glDeleteProgram (program_object_id);
+
+                    // Si se vuelve a crear el programa (al recuperar el contexto) los valores de los
+                    // uniforms se tienen que volver a enviar:
+
+                    for (auto & entry : uniforms) entry.second.dirty = true;
+
+                    uniforms_dirty = !uniforms.empty ();
+
+                    initialized = false;
                 }
             }
 
@@ -104,16 +147,19 @@
 
         public:
 
-            void use () const
+            /**
+             * Activa el programa y le envía los valores de los uniforms que han cambiado desde la
+             * última vez que se usó. Se debe llamar justo antes de dibujar con él.
+             */
+            void use ()
             {
                 assert(is_usable ());
 
-                if (this != active_shader_program)
-                {
-                    glUseProgram (program_object_id);
+                GL_State::use_program (program_object_id);
 
-                    active_shader_program = this;
-                }
+                active_shader_program = this;
+
+                if (uniforms_dirty) upload_uniforms ();
             }
 
         public:
@@ -129,20 +175,33 @@
                 return (uniform_id);
             }
 
-            void set_uniform_value (GLint uniform_id, const GLint     & value     ) const { glUniform1i  (uniform_id, value); }
-            void set_uniform_value (GLint uniform_id, const float     & value     ) const { glUniform1f  (uniform_id, value); }
-            void set_uniform_value (GLint uniform_id, const float    (& vector)[2]) const { glUniform2f  (uniform_id, vector[0], vector[1]); }
-            void set_uniform_value (GLint uniform_id, const float    (& vector)[3]) const { glUniform3f  (uniform_id, vector[0], vector[1], vector[2]); }
-            void set_uniform_value (GLint uniform_id, const float    (& vector)[4]) const { glUniform4f  (uniform_id, vector[0], vector[1], vector[2], vector[3]); }
-            void set_uniform_value (GLint uniform_id, const Point2f   & point     ) const { glUniform2f  (uniform_id,  point[0],  point[1]); }
-            void set_uniform_value (GLint uniform_id, const Point3f   & point     ) const { glUniform3f  (uniform_id,  point[0],  point[1],  point[2]); }
-            void set_uniform_value (GLint uniform_id, const Point4f   & point     ) const { glUniform4f  (uniform_id,  point[0],  point[1],  point[2],  point[3]); }
-            void set_uniform_value (GLint uniform_id, const Vector2f  & vector    ) const { glUniform2f  (uniform_id, vector[0], vector[1]); }
-            void set_uniform_value (GLint uniform_id, const Vector3f  & vector    ) const { glUniform3f  (uniform_id, vector[0], vector[1], vector[2]); }
-            void set_uniform_value (GLint uniform_id, const Vector4f  & vector    ) const { glUniform4f  (uniform_id, vector[0], vector[1], vector[2], vector[3]); }
-            void set_uniform_value (GLint uniform_id, const Matrix22f & matrix    ) const { glUniformMatrix2fv (uniform_id, 1, GL_FALSE, matrix.values); }
-            void set_uniform_value (GLint uniform_id, const Matrix33f & matrix    ) const { glUniformMatrix3fv (uniform_id, 1, GL_FALSE, matrix.values); }
-            void set_uniform_value (GLint uniform_id, const Matrix44f & matrix    ) const { glUniformMatrix4fv (uniform_id, 1, GL_FALSE, matrix.values); }
+            /*
+             * Los valores de los uniforms no se envían al momento, sino al usar el programa, de modo
+             * que no hace falta activarlo antes de darles valor y los valores repetidos no generan
+             * llamadas a OpenGL.
+             */
+
+            void set_uniform_value (GLint uniform_id, const GLint     & value     ) { store (uniform_id, value); }
+            void set_uniform_value (GLint uniform_id, const float     & value     ) { store (uniform_id, Uniform::VECTOR, &value, 1); }
+            void set_uniform_value (GLint uniform_id, const float    (& vector)[2]) { store (uniform_id, Uniform::VECTOR, vector, 2); }
+            void set_uniform_value (GLint uniform_id, const float    (& vector)[3]) { store (uniform_id, Uniform::VECTOR, vector, 3); }
+            void set_uniform_value (GLint uniform_id, const float    (& vector)[4]) { store (uniform_id, Uniform::VECTOR, vector, 4); }
+            void set_uniform_value (GLint uniform_id, const Point2f   & point     ) { float values[] = {  point[0],  point[1]                       }; store (uniform_id, Uniform::VECTOR, values, 2); }
+            void set_uniform_value (GLint uniform_id, const Point3f   & point     ) { float values[] = {  point[0],  point[1],  point[2]            }; store (uniform_id, Uniform::VECTOR, values, 3); }
+            void set_uniform_value (GLint uniform_id, const Point4f   & point     ) { float values[] = {  point[0],  point[1],  point[2],  point[3] }; store (uniform_id, Uniform::VECTOR, values, 4); }
+            void set_uniform_value (GLint uniform_id, const Vector2f  & vector    ) { float values[] = { vector[0], vector[1]                       }; store (uniform_id, Uniform::VECTOR, values, 2); }
+            void set_uniform_value (GLint uniform_id, const Vector3f  & vector    ) { float values[] = { vector[0], vector[1], vector[2]            }; store (uniform_id, Uniform::VECTOR, values, 3); }
+            void set_uniform_value (GLint uniform_id, const Vector4f  & vector    ) { float values[] = { vector[0], vector[1], vector[2], vector[3] }; store (uniform_id, Uniform::VECTOR, values, 4); }
+            void set_uniform_value (GLint uniform_id, const Matrix22f & matrix    ) { store (uniform_id, Uniform::MATRIX, matrix.values,  4); }
+            void set_uniform_value (GLint uniform_id, const Matrix33f & matrix    ) { store (uniform_id, Uniform::MATRIX, matrix.values,  9); }
+            void set_uniform_value (GLint uniform_id, const Matrix44f & matrix    ) { store (uniform_id, Uniform::MATRIX, matrix.values, 16); }
+
+        private:
+
+            void store (GLint uniform_id, GLint value);
+            void store (GLint uniform_id, Uniform::Type type, const float * values, unsigned size);
+
+            void upload_uniforms ();
 
         public:
 
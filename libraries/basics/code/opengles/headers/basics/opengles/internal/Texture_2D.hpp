@@ -13,8 +13,10 @@
 #ifndef BASICS_OPENGLES_TEXTURE_2D_HEADER
 #define BASICS_OPENGLES_TEXTURE_2D_HEADER
 
+    #include <basics/assert>
     #include <basics/Color_Buffer>
     #include <basics/Graphics_Resource>
+    #include <basics/opengles/GL_State>
     #include <basics/opengles/OpenGL_ES2>
     #include <basics/Texture_2D>
 
@@ -23,8 +25,19 @@
 
         class Texture_2D : public basics::Texture_2D
         {
+        public:
+
+            // Valor de get_backend() de las texturas de este módulo (sea cual sea la versión del contexto):
+
+            static constexpr Id backend_id = ID(opengles);
 
-            static const Texture_2D * active_texture;
+            /**
+             * Convierte una textura a este tipo si la ha creado este módulo o retorna nullptr si no.
+             */
+            static const Texture_2D * cast (const basics::Texture_2D * texture)
+            {
+                return texture && texture->get_backend () == backend_id ? static_cast< const Texture_2D * >(texture) : nullptr;
+            }
 
         public:
 
@@ -35,11 +48,12 @@
             static void enable ()
             {
                 register_factory (ID(opengles2), basics::opengles::Texture_2D::create);
+                register_factory (ID(opengles3), basics::opengles::Texture_2D::create);
             }
 
             static void unuse ()
             {
-                glBindTexture (GL_TEXTURE_2D, 0);
+                GL_State::bind_texture (0);
             }
 
         private:
@@ -51,7 +65,7 @@
 
             Texture_2D(const Color_Buffer< Rgba8888 > & color_buffer, unsigned width, unsigned height)
             :
-                basics::Texture_2D(width, height),
+                basics::Texture_2D(backend_id, width, height),
                 color_buffer      (color_buffer )
             {
             }
@@ -60,8 +74,6 @@
 
            ~Texture_2D()
             {
-                if (active_texture == this) active_texture = nullptr;
-
                 finalize ();
             }
 
@@ -73,7 +85,11 @@
             {
                 if (initialized)
                 {
+                    GL_State::forget_texture (texture_object_id);
+
                     glDeleteTextures (1, &texture_object_id);
+
+                    initialized = false;
                 }
             }
 
@@ -86,7 +102,12 @@
 
         public:
 
-            bool use () const;
+            void use () const
+            {
+                assert(is_usable ());
+
+                GL_State::bind_texture (texture_object_id);
+            }
 
         };
 
@@ -10,9 +10,11 @@
  * C1801091703
  */
 
+#include <cstddef>
 #include <basics/Transformation>
 #include <basics/opengles/OpenGL_ES2>
 #include <basics/opengles/Canvas_ES2>
+#include <basics/opengles/GL_State>
 #include <basics/opengles/Shader_Program>
 #include <basics/opengles/Texture_2D>
 
@@ -44,6 +46,22 @@ namespace basics { namespace opengles
             "gl_Position = vec4((vec3(vertex_position, 1.0) * transform * projection).xy, 0.0, 1.0);"
         "}";
 
+    const char * Canvas_ES2::internal_vertex_shader_b =
+        "precision mediump float;"
+        "uniform   mat3  transform;"
+        "uniform   mat3  projection;"
+        "attribute vec2  vertex_position;"
+        "attribute vec2  vertex_texture_uv;"
+        "attribute float vertex_opacity;"
+        "varying   vec2  varying_uv;"
+        "varying   float varying_opacity;"
+        "void main()"
+        "{"
+            "varying_uv      = vertex_texture_uv;"
+            "varying_opacity = vertex_opacity;"
+            "gl_Position     = vec4((vec3(vertex_position, 1.0) * transform * projection).xy, 0.0, 1.0);"
+        "}";
+
     const char * Canvas_ES2::internal_fragment_shader_f =
         "precision mediump float;"
         "uniform vec3  color;"
@@ -64,6 +82,17 @@ namespace basics { namespace opengles
             "gl_FragColor = vec4(texel.rgb, texel.a * opacity);"
         "}";
 
+    const char * Canvas_ES2::internal_fragment_shader_b =
+        "precision mediump   float;"
+        "uniform   sampler2D sampler;"
+        "varying   vec2      varying_uv;"
+        "varying   float     varying_opacity;"
+        "void main()"
+        "{"
+            "vec4 texel   = texture2D (sampler, varying_uv);"
+            "gl_FragColor = vec4(texel.rgb, texel.a * varying_opacity);"
+        "}";
+
     static const Point2f normal_texture_uvs[] =
     {
         { 0.f, 1.f },
@@ -124,6 +153,8 @@ namespace basics { namespace opengles
             projection_f_id = shader_program_f->get_uniform_id ("projection");
                  color_f_id = shader_program_f->get_uniform_id ("color"     );
                opacity_f_id = shader_program_f->get_uniform_id ("opacity"   );
+
+            vertex_position_location_f = shader_program_f->get_vertex_attribute_id ("vertex_position");
         }
 
         shader_program_t.reset (new Shader_Program);
@@ -148,13 +179,86 @@ namespace basics { namespace opengles
             shader_program_t->set_uniform_value (sampler_t_id, 0);
         }
 
+        shader_program_b.reset (new Shader_Program);
+
+        shader_program_b->add (Shader::Source_Code::from_string (internal_vertex_shader_b,   Shader::Source_Code::VERTEX  ));
+        shader_program_b->add (Shader::Source_Code::from_string (internal_fragment_shader_b, Shader::Source_Code::FRAGMENT));
+
+        context->add (shader_program_b);
+
+        if (shader_program_b->is_usable ())
+        {
+            shader_program_b->use ();
+
+             transform_b_id = shader_program_b->get_uniform_id ("transform" );
+            projection_b_id = shader_program_b->get_uniform_id ("projection");
+               sampler_b_id = shader_program_b->get_uniform_id ("sampler"   );
+
+              vertex_position_location_b = shader_program_b->get_vertex_attribute_id ("vertex_position"  );
+            vertex_texture_uv_location_b = shader_program_b->get_vertex_attribute_id ("vertex_texture_uv");
+               vertex_opacity_location_b = shader_program_b->get_vertex_attribute_id ("vertex_opacity"   );
+
+            shader_program_b->set_uniform_value (sampler_b_id, 0);
+        }
+
+        // Los índices de los quads del lote no cambian nunca, por lo que se suben una sola vez.
+        // Cada quad se dibuja como dos triángulos con el mismo orden de vértices que el strip que
+        // usan los métodos no agrupados:
+
+        std::vector< GLushort > indices(batch_capacity * 6);
+
+        for (unsigned quad = 0, index = 0; quad < batch_capacity; ++quad)
+        {
+            GLushort first = GLushort(quad * 4);
+
+            indices[index++] = first + 0;
+            indices[index++] = first + 1;
+            indices[index++] = first + 2;
+            indices[index++] = first + 2;
+            indices[index++] = first + 1;
+            indices[index++] = first + 3;
+        }
+
+        GLuint buffers[2];
+
+        glGenBuffers (2, buffers);
+
+        batch_vertex_buffer = buffers[0];
+        batch_index_buffer  = buffers[1];
+
+        GL_State::bind_buffer (GL_ELEMENT_ARRAY_BUFFER, batch_index_buffer);
+
+        glBufferData (GL_ELEMENT_ARRAY_BUFFER, GLsizeiptr(indices.size () * sizeof(GLushort)), indices.data (), GL_STATIC_DRAW);
+
+        batch_vertices.reserve (batch_capacity * 4);
+
+        batching         = false;
+        batch_texture    = nullptr;
+        statistics       = { 0, 0, 0, 0 };
+        frame_statistics = { 0, 0, 0, 0 };
+
         reset_state ();
     }
 
+    Canvas_ES2::~Canvas_ES2()
+    {
+        GLuint buffers[] = { batch_vertex_buffer, batch_index_buffer };
+
+        GL_State::forget_buffer (batch_vertex_buffer);
+        GL_State::forget_buffer (batch_index_buffer );
+
+        glDeleteBuffers (2, buffers);
+    }
+
     void Canvas_ES2::reset_state ()
     {
-        glEnable      (GL_BLEND);
-        glBlendFunc   (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        flush_batch   ();
+
+        // Las escenas pueden haber cambiado el estado de OpenGL sin pasar por GL_State:
+
+        GL_State::invalidate   ();
+        GL_State::set_blending (true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
         glClearColor  (0.f, 0.f, 0.f, 1.f);
 
         set_size      ({ unsigned(size.width), unsigned(size.height) });
@@ -163,18 +267,43 @@ namespace basics { namespace opengles
         set_opacity   (1.f);
     }
 
+    void Canvas_ES2::set_batching (bool enabled)
+    {
+        if (!enabled) flush_batch ();
+
+        batching = enabled;
+    }
+
+    void Canvas_ES2::flush ()
+    {
+        flush_batch ();
+
+        // Los cambios de estado se cuentan en GL_State, que también usan los recursos (texturas y
+        // programas) al inicializarse:
+
+        const GL_State::Counters & counters = GL_State::get_counters ();
+
+        statistics.state_changes         = counters.issued;
+        statistics.skipped_state_changes = counters.skipped;
+
+        frame_statistics = statistics;
+        statistics       = { 0, 0, 0, 0 };
+
+        GL_State::reset_counters ();
+    }
+
     void Canvas_ES2::set_size (const Size2u & new_viewport_size)
     {
+        flush_batch ();
+
         size.width  = float(new_viewport_size.width );
         size.height = float(new_viewport_size.height);
         half_size   = size * 0.5f;
         projection  = translate_then_scale_2d (Vector2f{ -half_size.width, -half_size.height }, 2.f / size.width, 2.f / size.height);
 
-        shader_program_f->use ();
         shader_program_f->set_uniform_value (projection_f_id, projection.matrix);
-
-        shader_program_t->use ();
         shader_program_t->set_uniform_value (projection_t_id, projection.matrix);
+        shader_program_b->set_uniform_value (projection_b_id, projection.matrix);
     }
 
     void Canvas_ES2::set_clear_color (float r, float g, float b)
@@ -182,95 +311,153 @@ namespace basics { namespace opengles
         glClearColor (r, g, b, 1.f);
     }
 
-    void Canvas_ES2::set_opacity (float opacity)
+    void Canvas_ES2::set_opacity (float new_opacity)
     {
-        shader_program_f->use ();
+        // La opacidad de los quads agrupados viaja en cada vértice, por lo que cambiarla no obliga
+        // a volcar el lote:
+
+        opacity = new_opacity;
+
+        // Los valores se envían a cada programa cuando se dibuja con él:
+
         shader_program_f->set_uniform_value (opacity_f_id, opacity);
-        shader_program_t->use ();
         shader_program_t->set_uniform_value (opacity_t_id, opacity);
     }
 
+    void Canvas_ES2::set_blending (Blending blending)
+    {
+        flush_batch ();
+
+        switch (blending)
+        {
+            case NONE:         GL_State::set_blending (false);                                       break;
+            case TRANSPARENCY: GL_State::set_blending (true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); break;
+            case MULTIPLY:     GL_State::set_blending (true, GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA); break;
+            case ADD:          GL_State::set_blending (true, GL_SRC_ALPHA, GL_ONE                ); break;
+        }
+    }
+
     void Canvas_ES2::set_color (float r, float g, float b)
     {
-        shader_program_f->use ();
         shader_program_f->set_uniform_value (color_f_id, Vector3f{ r, g, b });
     }
 
     void Canvas_ES2::set_transform (const Transformation2f & new_transform)
     {
+        flush_batch ();
+
         transform = new_transform;
 
-        shader_program_f->use ();
         shader_program_f->set_uniform_value (transform_f_id, transform.matrix);
-
-        shader_program_t->use ();
         shader_program_t->set_uniform_value (transform_t_id, transform.matrix);
+        shader_program_b->set_uniform_value (transform_b_id, transform.matrix);
     }
 
     void Canvas_ES2::apply_transform (const Transformation2f & t)
     {
+        flush_batch ();
+
         transform = t * transform;
 
-        shader_program_f->use ();
         shader_program_f->set_uniform_value (transform_f_id, transform.matrix);
-
-        shader_program_t->use ();
         shader_program_t->set_uniform_value (transform_t_id, transform.matrix);
+        shader_program_b->set_uniform_value (transform_b_id, transform.matrix);
     }
 
     void Canvas_ES2::clear ()
     {
+        flush_batch ();
+
         glClear (GL_COLOR_BUFFER_BIT);
     }
 
     void Canvas_ES2::draw_point (const Point2f & position)
     {
+        flush_batch ();
+
         shader_program_f->use ();
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, position.coordinates);
-        glDrawArrays               (GL_POINTS, 0, 1);
+        GL_State::bind_buffer           (GL_ARRAY_BUFFER, 0);
+        GL_State::set_vertex_attributes (1u << vertex_position_location_f);
+
+        glVertexAttribPointer (vertex_position_location_f, 2, GL_FLOAT, GL_FALSE, 0, position.coordinates);
+        glDrawArrays          (GL_POINTS, 0, 1);
+
+        count_draw_call (1);
     }
 
     void Canvas_ES2::draw_segment (const Point2f & a, const Point2f & b)
     {
+        flush_batch ();
+
         shader_program_f->use ();
 
         const Point2f coordinates[] = { a, b };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_LINES, 0, 2);
+        GL_State::bind_buffer           (GL_ARRAY_BUFFER, 0);
+        GL_State::set_vertex_attributes (1u << vertex_position_location_f);
+
+        glVertexAttribPointer (vertex_position_location_f, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
+        glDrawArrays          (GL_LINES, 0, 2);
+
+        count_draw_call (2);
     }
 
     void Canvas_ES2::draw_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
     {
+        flush_batch ();
+
         shader_program_f->use ();
 
         const Point2f coordinates[] = { a, b, c, a };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_LINE_STRIP, 0, 4);
+        GL_State::bind_buffer           (GL_ARRAY_BUFFER, 0);
+        GL_State::set_vertex_attributes (1u << vertex_position_location_f);
+
+        glVertexAttribPointer (vertex_position_location_f, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
+        glDrawArrays          (GL_LINE_STRIP, 0, 4);
+
+        count_draw_call (4);
     }
 
     void Canvas_ES2::fill_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
     {
+        flush_batch ();
+
         shader_program_f->use ();
 
         const Point2f coordinates[] = { a, b, c };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_TRIANGLES, 0, 3);
+        GL_State::bind_buffer           (GL_ARRAY_BUFFER, 0);
+        GL_State::set_vertex_attributes (1u << vertex_position_location_f);
+
+        glVertexAttribPointer (vertex_position_location_f, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
+        glDrawArrays          (GL_TRIANGLES, 0, 3);
+
+        count_draw_call (3);
+    }
+
+    void Canvas_ES2::fill_strip (const Point2f * vertices, unsigned count)
+    {
+        if (count < 3) return;
+
+        flush_batch ();
+
+        shader_program_f->use ();
+
+        GL_State::bind_buffer           (GL_ARRAY_BUFFER, 0);
+        GL_State::set_vertex_attributes (1u << vertex_position_location_f);
+
+        glVertexAttribPointer (vertex_position_location_f, 2, GL_FLOAT, GL_FALSE, 0, vertices);
+        glDrawArrays          (GL_TRIANGLE_STRIP, 0, GLsizei(count));
+
+        count_draw_call (count);
     }
 
     void Canvas_ES2::draw_rectangle (const Point2f & bottom_left, const Size2f & size)
     {
+        flush_batch ();
+
         shader_program_f->use ();
 
         Point2f top_right{ bottom_left.coordinates.x () + size.width, bottom_left.coordinates.y () + size.height };
@@ -284,14 +471,19 @@ namespace basics { namespace opengles
               bottom_left
         };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_LINE_STRIP, 0, 5);
+        GL_State::bind_buffer           (GL_ARRAY_BUFFER, 0);
+        GL_State::set_vertex_attributes (1u << vertex_position_location_f);
+
+        glVertexAttribPointer (vertex_position_location_f, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
+        glDrawArrays          (GL_LINE_STRIP, 0, 5);
+
+        count_draw_call (5);
     }
 
     void Canvas_ES2::fill_rectangle (const Point2f & bottom_left, const Size2f & size)
     {
+        flush_batch ();
+
         shader_program_f->use ();
 
         Point2f top_right{ bottom_left.coordinates.x () + size.width, bottom_left.coordinates.y () + size.height };
@@ -304,15 +496,18 @@ namespace basics { namespace opengles
                 top_right,
         };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_TRIANGLE_STRIP, 0, 4);
+        GL_State::bind_buffer           (GL_ARRAY_BUFFER, 0);
+        GL_State::set_vertex_attributes (1u << vertex_position_location_f);
+
+        glVertexAttribPointer (vertex_position_location_f, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
+        glDrawArrays          (GL_TRIANGLE_STRIP, 0, 4);
+
+        count_draw_call (4);
     }
 
     void Canvas_ES2::fill_rectangle (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling)
     {
-        const opengles::Texture_2D * opengl_es_texture = dynamic_cast< const opengles::Texture_2D * >(texture);
+        const opengles::Texture_2D * opengl_es_texture = opengles::Texture_2D::cast (texture);
 
         if (opengl_es_texture)
         {
@@ -356,14 +551,26 @@ namespace basics { namespace opengles
                     top_right,
             };
 
+            if (batching)
+            {
+                batch_quad (opengl_es_texture, coordinates, texture_uvs);
+
+                return;
+            }
+
+            flush_batch ();
+
             opengl_es_texture->use ();
             shader_program_t ->use ();
 
-            glEnableVertexAttribArray (  vertex_position_location_t);
-            glEnableVertexAttribArray (vertex_texture_uv_location_t);
-            glVertexAttribPointer     (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-            glVertexAttribPointer     (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
-            glDrawArrays              (GL_TRIANGLE_STRIP, 0, 4);
+            GL_State::bind_buffer           (GL_ARRAY_BUFFER, 0);
+            GL_State::set_vertex_attributes ((1u << vertex_position_location_t) | (1u << vertex_texture_uv_location_t));
+
+            glVertexAttribPointer (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
+            glVertexAttribPointer (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
+            glDrawArrays          (GL_TRIANGLE_STRIP, 0, 4);
+
+            count_draw_call (4);
         }
     }
 
@@ -374,16 +581,16 @@ namespace basics { namespace opengles
             return;
         }
 
-        const opengles::Texture_2D * opengl_es_texture = dynamic_cast< const opengles::Texture_2D * >(slice->atlas->get_texture ().get ());
+        const opengles::Texture_2D * opengl_es_texture = opengles::Texture_2D::cast (slice->atlas->get_texture ().get ());
 
         if (opengl_es_texture)
         {
-            float   horizontal_ratio  = 1.f / opengl_es_texture->get_width  ();
-            float     vertical_ratio  = 1.f / opengl_es_texture->get_height ();
-            float   normalized_left   = slice->left   * horizontal_ratio;
-            float   normalized_right  = slice->right  * horizontal_ratio;
-            float   normalized_top    = slice->top    *   vertical_ratio;
-            float   normalized_bottom = slice->bottom *   vertical_ratio;
+            // Las coordenadas de textura del slice ya vienen normalizadas desde el atlas:
+
+            float   normalized_left   = slice->texture_left;
+            float   normalized_right  = slice->texture_right;
+            float   normalized_top    = slice->texture_top;
+            float   normalized_bottom = slice->texture_bottom;
 
             Point2f bottom_left;
             Point2f texture_uvs[] =
@@ -434,15 +641,84 @@ namespace basics { namespace opengles
                     top_right,
             };
 
+            if (batching)
+            {
+                batch_quad (opengl_es_texture, coordinates, texture_uvs);
+
+                return;
+            }
+
+            flush_batch ();
+
             opengl_es_texture->use ();
             shader_program_t ->use ();
 
-            glEnableVertexAttribArray (  vertex_position_location_t);
-            glEnableVertexAttribArray (vertex_texture_uv_location_t);
-            glVertexAttribPointer     (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-            glVertexAttribPointer     (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
-            glDrawArrays              (GL_TRIANGLE_STRIP, 0, 4);
+            GL_State::bind_buffer           (GL_ARRAY_BUFFER, 0);
+            GL_State::set_vertex_attributes ((1u << vertex_position_location_t) | (1u << vertex_texture_uv_location_t));
+
+            glVertexAttribPointer (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
+            glVertexAttribPointer (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
+            glDrawArrays          (GL_TRIANGLE_STRIP, 0, 4);
+
+            count_draw_call (4);
+        }
+    }
+
+    void Canvas_ES2::batch_quad (const Texture_2D * texture, const Point2f (& coordinates)[4], const Point2f * texture_uvs)
+    {
+        // El lote se vuelca cuando cambia la textura o cuando se llena:
+
+        if (texture != batch_texture || batch_vertices.size () >= batch_capacity * 4)
+        {
+            flush_batch ();
+
+            batch_texture = texture;
+        }
+
+        for (unsigned index = 0; index < 4; ++index)
+        {
+            batch_vertices.push_back
+            ({
+                coordinates[index][0], coordinates[index][1],
+                texture_uvs[index][0], texture_uvs[index][1],
+                opacity
+            });
         }
     }
 
+    void Canvas_ES2::flush_batch ()
+    {
+        if (batch_vertices.empty ())
+        {
+            return;
+        }
+
+        batch_texture   ->use ();
+        shader_program_b->use ();
+
+        GL_State::bind_buffer (GL_ARRAY_BUFFER,         batch_vertex_buffer);
+        GL_State::bind_buffer (GL_ELEMENT_ARRAY_BUFFER, batch_index_buffer );
+
+        // Se suelta el contenido anterior del buffer antes de rellenarlo (orphaning) para que el driver
+        // no tenga que esperar a que la GPU termine de usarlo:
+
+        glBufferData (GL_ARRAY_BUFFER, GLsizeiptr(batch_vertices.size () * sizeof(Batch_Vertex)), batch_vertices.data (), GL_STREAM_DRAW);
+
+        GL_State::set_vertex_attributes ((1u << vertex_position_location_b) | (1u << vertex_texture_uv_location_b) | (1u << vertex_opacity_location_b));
+
+        glVertexAttribPointer (  vertex_position_location_b, 2, GL_FLOAT, GL_FALSE, sizeof(Batch_Vertex), reinterpret_cast< const void * >(offsetof(Batch_Vertex, x      )));
+        glVertexAttribPointer (vertex_texture_uv_location_b, 2, GL_FLOAT, GL_FALSE, sizeof(Batch_Vertex), reinterpret_cast< const void * >(offsetof(Batch_Vertex, u      )));
+        glVertexAttribPointer (   vertex_opacity_location_b, 1, GL_FLOAT, GL_FALSE, sizeof(Batch_Vertex), reinterpret_cast< const void * >(offsetof(Batch_Vertex, opacity)));
+        glDrawElements        (GL_TRIANGLES, GLsizei(batch_vertices.size () / 4 * 6), GL_UNSIGNED_SHORT, nullptr);
+
+        // Los buffers se quedan ligados: los métodos que usan arrays de vértices en memoria del
+        // cliente desligan el de vértices a través de GL_State solo si hace falta.
+
+        count_draw_call (unsigned(batch_vertices.size ()));
+
+        batch_vertices.clear ();
+
+        batch_texture = nullptr;
+    }
+
 }}
@@ -0,0 +1,279 @@
+/*
+ * OPENGL ES 3 CANVAS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802261200
+ */
+
+#include <cstddef>
+#include <EGL/egl.h>
+#include <basics/opengles/OpenGL_ES2>
+#include <basics/opengles/Canvas_ES3>
+#include <basics/opengles/GL_State>
+#include <basics/opengles/Shader_Program>
+#include <basics/opengles/Texture_2D>
+
+namespace basics { namespace opengles
+{
+
+    namespace
+    {
+
+        // Las funciones de OpenGL ES 3 no se enlazan directamente porque libGLESv3 solo existe a
+        // partir de Android 4.3. Se piden a EGL, que las retorna cuando el driver las implementa:
+
+        typedef void (GL_APIENTRY * Gen_Vertex_Arrays    ) (GLsizei count, GLuint * arrays);
+        typedef void (GL_APIENTRY * Delete_Vertex_Arrays ) (GLsizei count, const GLuint * arrays);
+        typedef void (GL_APIENTRY * Bind_Vertex_Array    ) (GLuint array);
+        typedef void (GL_APIENTRY * Vertex_Attrib_Divisor) (GLuint index, GLuint divisor);
+        typedef void (GL_APIENTRY * Draw_Arrays_Instanced) (GLenum mode, GLint first, GLsizei count, GLsizei instance_count);
+
+        Gen_Vertex_Arrays     gen_vertex_arrays     = nullptr;
+        Delete_Vertex_Arrays  delete_vertex_arrays  = nullptr;
+        Bind_Vertex_Array     bind_vertex_array     = nullptr;
+        Vertex_Attrib_Divisor vertex_attrib_divisor = nullptr;
+        Draw_Arrays_Instanced draw_arrays_instanced = nullptr;
+
+        bool load_functions ()
+        {
+            gen_vertex_arrays     = reinterpret_cast< Gen_Vertex_Arrays     >(eglGetProcAddress ("glGenVertexArrays"    ));
+            delete_vertex_arrays  = reinterpret_cast< Delete_Vertex_Arrays  >(eglGetProcAddress ("glDeleteVertexArrays" ));
+            bind_vertex_array     = reinterpret_cast< Bind_Vertex_Array     >(eglGetProcAddress ("glBindVertexArray"    ));
+            vertex_attrib_divisor = reinterpret_cast< Vertex_Attrib_Divisor >(eglGetProcAddress ("glVertexAttribDivisor"));
+            draw_arrays_instanced = reinterpret_cast< Draw_Arrays_Instanced >(eglGetProcAddress ("glDrawArraysInstanced"));
+
+            return gen_vertex_arrays && delete_vertex_arrays && bind_vertex_array && vertex_attrib_divisor && draw_arrays_instanced;
+        }
+
+        // Esquinas del quad unidad en el mismo orden que el strip de Canvas_ES2:
+
+        const GLfloat quad_corners[] =
+        {
+            0.f, 0.f,
+            0.f, 1.f,
+            1.f, 0.f,
+            1.f, 1.f,
+        };
+
+    }
+
+    const char * Canvas_ES3::internal_vertex_shader_i =
+        "#version 300 es\n"
+        "precision mediump float;"
+        "uniform mat3  transform;"
+        "uniform mat3  projection;"
+        "in      vec2  vertex_corner;"
+        "in      vec4  instance_rectangle;"
+        "in      vec4  instance_texture_uvs;"
+        "in      float instance_opacity;"
+        "out     vec2  varying_uv;"
+        "out     float varying_opacity;"
+        "void main()"
+        "{"
+            "vec2 position   = instance_rectangle.xy + vertex_corner * instance_rectangle.zw;"
+            "varying_uv      = mix (instance_texture_uvs.xy, instance_texture_uvs.zw, vertex_corner);"
+            "varying_opacity = instance_opacity;"
+            "gl_Position     = vec4((vec3(position, 1.0) * transform * projection).xy, 0.0, 1.0);"
+        "}";
+
+    const char * Canvas_ES3::internal_fragment_shader_i =
+        "#version 300 es\n"
+        "precision mediump   float;"
+        "uniform   sampler2D sampler;"
+        "in        vec2      varying_uv;"
+        "in        float     varying_opacity;"
+        "out       vec4      fragment_color;"
+        "void main()"
+        "{"
+            "vec4 texel    = texture (sampler, varying_uv);"
+            "fragment_color = vec4(texel.rgb, texel.a * varying_opacity);"
+        "}";
+
+    Canvas * Canvas_ES3::create (Id id, Graphics_Context::Accessor & context, const Options & options)
+    {
+        std::shared_ptr< Canvas >  canvas(new Canvas_ES3(context, options.size));
+
+        context->add (id, canvas);
+
+        return canvas.get ();
+    }
+
+    Canvas_ES3::Canvas_ES3(Graphics_Context::Accessor & context, const Size2u & size)
+    :
+        Canvas_ES2(context, size)
+    {
+        instancing      = false;
+        vertex_array    = 0;
+        corner_buffer   = 0;
+        instance_buffer = 0;
+
+        if (load_functions ())
+        {
+            shader_program_i.reset (new Shader_Program);
+
+            shader_program_i->add (Shader::Source_Code::from_string (internal_vertex_shader_i,   Shader::Source_Code::VERTEX  ));
+            shader_program_i->add (Shader::Source_Code::from_string (internal_fragment_shader_i, Shader::Source_Code::FRAGMENT));
+
+            context->add (shader_program_i);
+
+            instancing = shader_program_i->is_usable ();
+        }
+
+        if (instancing)
+        {
+            shader_program_i->use ();
+
+             transform_i_id = shader_program_i->get_uniform_id ("transform" );
+            projection_i_id = shader_program_i->get_uniform_id ("projection");
+               sampler_i_id = shader_program_i->get_uniform_id ("sampler"   );
+
+            GLuint corner_location    = shader_program_i->get_vertex_attribute_id ("vertex_corner"       );
+            GLuint rectangle_location = shader_program_i->get_vertex_attribute_id ("instance_rectangle"  );
+            GLuint uvs_location       = shader_program_i->get_vertex_attribute_id ("instance_texture_uvs");
+            GLuint opacity_location   = shader_program_i->get_vertex_attribute_id ("instance_opacity"    );
+
+            shader_program_i->set_uniform_value (sampler_i_id, 0);
+
+            GLuint buffers[2];
+
+            glGenBuffers (2, buffers);
+
+            corner_buffer   = buffers[0];
+            instance_buffer = buffers[1];
+
+            GL_State::bind_buffer (GL_ARRAY_BUFFER, corner_buffer);
+
+            glBufferData (GL_ARRAY_BUFFER, sizeof(quad_corners), quad_corners, GL_STATIC_DRAW);
+
+            // Los atributos habilitados y sus punteros quedan guardados en el vertex array object,
+            // de modo que no cambian el estado del vertex array por defecto que controla GL_State:
+
+            gen_vertex_arrays (1, &vertex_array);
+            bind_vertex_array (vertex_array);
+
+            glEnableVertexAttribArray (corner_location);
+            glVertexAttribPointer     (corner_location, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+            GL_State::bind_buffer (GL_ARRAY_BUFFER, instance_buffer);
+
+            glEnableVertexAttribArray (rectangle_location);
+            glEnableVertexAttribArray (uvs_location      );
+            glEnableVertexAttribArray (opacity_location  );
+
+            glVertexAttribPointer (rectangle_location, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), reinterpret_cast< const void * >(offsetof(Instance, left   )));
+            glVertexAttribPointer (uvs_location,       4, GL_FLOAT, GL_FALSE, sizeof(Instance), reinterpret_cast< const void * >(offsetof(Instance, u0     )));
+            glVertexAttribPointer (opacity_location,   1, GL_FLOAT, GL_FALSE, sizeof(Instance), reinterpret_cast< const void * >(offsetof(Instance, opacity)));
+
+            vertex_attrib_divisor (rectangle_location, 1);
+            vertex_attrib_divisor (uvs_location,       1);
+            vertex_attrib_divisor (opacity_location,   1);
+
+            bind_vertex_array (0);
+
+            instances.reserve (instance_capacity);
+        }
+
+        reset_state ();
+    }
+
+    Canvas_ES3::~Canvas_ES3()
+    {
+        if (instancing)
+        {
+            GLuint buffers[] = { corner_buffer, instance_buffer };
+
+            GL_State::forget_buffer (corner_buffer  );
+            GL_State::forget_buffer (instance_buffer);
+
+            glDeleteBuffers      (2, buffers);
+            delete_vertex_arrays (1, &vertex_array);
+        }
+    }
+
+    void Canvas_ES3::set_size (const Size2u & new_viewport_size)
+    {
+        Canvas_ES2::set_size (new_viewport_size);
+
+        if (instancing) shader_program_i->set_uniform_value (projection_i_id, projection.matrix);
+    }
+
+    void Canvas_ES3::set_transform (const Transformation2f & new_transform)
+    {
+        Canvas_ES2::set_transform (new_transform);
+
+        if (instancing) shader_program_i->set_uniform_value (transform_i_id, transform.matrix);
+    }
+
+    void Canvas_ES3::apply_transform (const Transformation2f & t)
+    {
+        Canvas_ES2::apply_transform (t);
+
+        if (instancing) shader_program_i->set_uniform_value (transform_i_id, transform.matrix);
+    }
+
+    void Canvas_ES3::batch_quad (const Texture_2D * texture, const Point2f (& coordinates)[4], const Point2f * texture_uvs)
+    {
+        if (!instancing)
+        {
+            Canvas_ES2::batch_quad (texture, coordinates, texture_uvs);
+            return;
+        }
+
+        if (texture != batch_texture || instances.size () >= instance_capacity)
+        {
+            flush_batch ();
+
+            batch_texture = texture;
+        }
+
+        // Los quads son rectángulos alineados con los ejes, por lo que basta con las esquinas opuestas
+        // (la transformación del canvas se aplica después a todo el lote):
+
+        instances.push_back
+        ({
+            coordinates[0][0], coordinates[0][1],
+            coordinates[3][0] - coordinates[0][0],
+            coordinates[3][1] - coordinates[0][1],
+            texture_uvs[0][0], texture_uvs[0][1],
+            texture_uvs[3][0], texture_uvs[3][1],
+            opacity
+        });
+    }
+
+    void Canvas_ES3::flush_batch ()
+    {
+        if (!instancing)
+        {
+            Canvas_ES2::flush_batch ();
+            return;
+        }
+
+        if (instances.empty ())
+        {
+            return;
+        }
+
+        batch_texture   ->use ();
+        shader_program_i->use ();
+
+        GL_State::bind_buffer (GL_ARRAY_BUFFER, instance_buffer);
+
+        glBufferData (GL_ARRAY_BUFFER, GLsizeiptr(instances.size () * sizeof(Instance)), instances.data (), GL_STREAM_DRAW);
+
+        bind_vertex_array     (vertex_array);
+        draw_arrays_instanced (GL_TRIANGLE_STRIP, 0, 4, GLsizei(instances.size ()));
+        bind_vertex_array     (0);
+
+        count_draw_call (unsigned(instances.size () * 4));
+
+        instances.clear ();
+
+        batch_texture = nullptr;
+    }
+
+}}
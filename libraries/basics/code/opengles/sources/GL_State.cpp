@@ -0,0 +1,148 @@
+/*
+ * GL STATE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * C1802111205
+ */
+
+#include <basics/opengles/GL_State>
+
+namespace basics { namespace opengles
+{
+
+    GLuint             GL_State::bound_texture        = GL_State::unknown;
+    GLuint             GL_State::current_program      = GL_State::unknown;
+    GLuint             GL_State::array_buffer         = GL_State::unknown;
+    GLuint             GL_State::element_array_buffer = GL_State::unknown;
+    uint32_t           GL_State::enabled_attributes   = 0;
+    bool               GL_State::attributes_known     = false;
+    int                GL_State::blending             = -1;
+    GLenum             GL_State::blend_source         = GL_NONE;
+    GLenum             GL_State::blend_destination    = GL_NONE;
+    bool               GL_State::texture_unit_known   = false;
+    GL_State::Counters GL_State::counters             = { 0, 0 };
+
+    void GL_State::invalidate ()
+    {
+        bound_texture        = unknown;
+        current_program      = unknown;
+        array_buffer         = unknown;
+        element_array_buffer = unknown;
+        attributes_known     = false;
+        blending             = -1;
+        blend_source         = GL_NONE;
+        blend_destination    = GL_NONE;
+        texture_unit_known   = false;
+    }
+
+    void GL_State::bind_texture (GLuint texture)
+    {
+        // Solo se usa la unidad de textura 0, por lo que basta con activarla una vez:
+
+        if (!texture_unit_known)
+        {
+            glActiveTexture (GL_TEXTURE0);
+
+            texture_unit_known = true;
+        }
+
+        if (issue (texture != bound_texture))
+        {
+            glBindTexture (GL_TEXTURE_2D, texture);
+
+            bound_texture = texture;
+        }
+    }
+
+    void GL_State::use_program (GLuint program)
+    {
+        if (issue (program != current_program))
+        {
+            glUseProgram (program);
+
+            current_program = program;
+        }
+    }
+
+    void GL_State::bind_buffer (GLenum target, GLuint buffer)
+    {
+        GLuint & bound_buffer = target == GL_ARRAY_BUFFER ? array_buffer : element_array_buffer;
+
+        if (issue (buffer != bound_buffer))
+        {
+            glBindBuffer (target, buffer);
+
+            bound_buffer = buffer;
+        }
+    }
+
+    void GL_State::set_vertex_attributes (uint32_t mask)
+    {
+        uint32_t changed = attributes_known ? mask ^ enabled_attributes : (1u << max_vertex_attributes) - 1;
+
+        for (unsigned index = 0; index < max_vertex_attributes; ++index)
+        {
+            uint32_t bit = 1u << index;
+
+            if (changed & bit)
+            {
+                if (mask & bit) glEnableVertexAttribArray (index); else glDisableVertexAttribArray (index);
+
+                counters.issued++;
+            }
+            else
+            if (mask & bit)
+            {
+                counters.skipped++;
+            }
+        }
+
+        enabled_attributes = mask;
+        attributes_known   = true;
+    }
+
+    void GL_State::set_blending (bool enabled, GLenum source, GLenum destination)
+    {
+        if (issue (blending != int(enabled)))
+        {
+            if (enabled) glEnable (GL_BLEND); else glDisable (GL_BLEND);
+
+            blending = int(enabled);
+        }
+
+        if (enabled && issue (source != blend_source || destination != blend_destination))
+        {
+            glBlendFunc (source, destination);
+
+            blend_source      = source;
+            blend_destination = destination;
+        }
+    }
+
+    void GL_State::forget_texture (GLuint texture)
+    {
+        // OpenGL vuelve a ligar la textura 0 al borrar la que está ligada:
+
+        if (texture == bound_texture) bound_texture = 0;
+    }
+
+    void GL_State::forget_program (GLuint program)
+    {
+        // Un programa borrado sigue en uso hasta que se cambia, pero se fuerza el siguiente cambio
+        // por si se crea otro con el mismo nombre:
+
+        if (program == current_program) current_program = unknown;
+    }
+
+    void GL_State::forget_buffer (GLuint buffer)
+    {
+        if (buffer == array_buffer        ) array_buffer         = 0;
+        if (buffer == element_array_buffer) element_array_buffer = 0;
+    }
+
+}}
@@ -8,6 +8,7 @@
  * angel.rodriguez@esne.edu
  */
 
+#include <cstring>
 #include <basics/opengles/Fragment_Shader>
 #include <basics/opengles/OpenGL_ES2>
 #include <basics/opengles/Shader_Program>
@@ -85,4 +86,96 @@ namespace basics { namespace opengles
         return succeeded != 0;
     }
 
+    void Shader_Program::store (GLint uniform_id, GLint value)
+    {
+        if (uniform_id == -1) return;
+
+        Uniform_Map::iterator  found   = uniforms.find (uniform_id);
+        Uniform              & uniform = found != uniforms.end () ? found->second : uniforms[uniform_id];
+
+        if (found == uniforms.end () || uniform.type != Uniform::INTEGER || uniform.integer != value)
+        {
+            uniform.type    = Uniform::INTEGER;
+            uniform.size    = 1;
+            uniform.integer = value;
+            uniform.dirty   = true;
+            uniforms_dirty  = true;
+        }
+    }
+
+    void Shader_Program::store (GLint uniform_id, Uniform::Type type, const float * values, unsigned size)
+    {
+        assert(size <= 16);
+
+        if (uniform_id == -1) return;
+
+        Uniform_Map::iterator  found   = uniforms.find (uniform_id);
+        Uniform              & uniform = found != uniforms.end () ? found->second : uniforms[uniform_id];
+
+        // Si el valor es el mismo que ya se tenía (enviado o pendiente de enviar) no hay nada que hacer:
+
+        if
+        (
+            found == uniforms.end ()      ||
+            uniform.type != type          ||
+            uniform.size != size          ||
+            std::memcmp (uniform.values, values, size * sizeof(float)) != 0
+        )
+        {
+            uniform.type   = type;
+            uniform.size   = size;
+            uniform.dirty  = true;
+            uniforms_dirty = true;
+
+            std::memcpy (uniform.values, values, size * sizeof(float));
+        }
+    }
+
+    void Shader_Program::upload_uniforms ()
+    {
+        for (auto & entry : uniforms)
+        {
+            GLint     location = entry.first;
+            Uniform & uniform  = entry.second;
+
+            if (!uniform.dirty) continue;
+
+            switch (uniform.type)
+            {
+                case Uniform::INTEGER:
+                {
+                    glUniform1i (location, uniform.integer);
+                    break;
+                }
+
+                case Uniform::VECTOR:
+                {
+                    switch (uniform.size)
+                    {
+                        case 1: glUniform1fv (location, 1, uniform.values); break;
+                        case 2: glUniform2fv (location, 1, uniform.values); break;
+                        case 3: glUniform3fv (location, 1, uniform.values); break;
+                        case 4: glUniform4fv (location, 1, uniform.values); break;
+                    }
+                    break;
+                }
+
+                case Uniform::MATRIX:
+                {
+                    switch (uniform.size)
+                    {
+                        case  4: glUniformMatrix2fv (location, 1, GL_FALSE, uniform.values); break;
+                        case  9: glUniformMatrix3fv (location, 1, GL_FALSE, uniform.values); break;
+                        case 16: glUniformMatrix4fv (location, 1, GL_FALSE, uniform.values); break;
+                    }
+                    break;
+                }
+            }
+
+            uniform.dirty = false;
+        }
+
+        uniforms_dirty = false;
+    }
+
 }}
@@ -16,7 +16,7 @@
 namespace basics { namespace opengles
 {
 
-    const Texture_2D * Texture_2D::active_texture = nullptr;
+    constexpr Id Texture_2D::backend_id;
 
     std::shared_ptr< basics::Texture_2D > Texture_2D::create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options)
     {
@@ -31,7 +31,8 @@ namespace basics { namespace opengles
             {
                 glEnable        (GL_TEXTURE_2D);////
                 glGenTextures   (1, &texture_object_id);
-                glBindTexture   (GL_TEXTURE_2D, texture_object_id);
+
+                GL_State::bind_texture (texture_object_id);
 
                 glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
                 glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -63,21 +64,4 @@ namespace basics { namespace opengles
         return initialized;
     }
 
-    bool Texture_2D::use () const
-    {
-        assert(is_usable ());
-
-        //if (active_texture != this)
-        {
-            glBindTexture   (GL_TEXTURE_2D, texture_object_id);
-            glActiveTexture (GL_TEXTURE0);
-
-            active_texture  = this;
-
-            return true;
-        }
-
-        return false;
-    }
-
 }}
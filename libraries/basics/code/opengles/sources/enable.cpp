@@ -12,7 +12,9 @@
 
 #include <basics/enable>
 #include <basics/opengles/Canvas_ES2>
+#include <basics/opengles/Canvas_ES3>
 #include <basics/opengles/OpenGL_ES2>
+#include <basics/opengles/OpenGL_ES3>
 #include <basics/opengles/Texture_2D>
 
 namespace basics
@@ -27,4 +29,17 @@ namespace basics
         return true;
     }
 
+    template< >
+    bool enable< OpenGL_ES3 > ()
+    {
+        // Canvas_ES3 se registra primero para que sea el que se use con los contextos de OpenGL ES 3.
+        // Canvas_ES2 queda para los contextos de OpenGL ES 2:
+
+        opengles::Canvas_ES3::enable ();
+        opengles::Canvas_ES2::enable ();
+        opengles::Texture_2D::enable ();
+
+        return true;
+    }
+
 }
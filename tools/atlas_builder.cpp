@@ -0,0 +1,209 @@
+/*
+ * ATLAS BUILDER
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+// Genera por adelantado los atlas que cargan las escenas: junta las imágenes indicadas en una o
+// varias páginas con Atlas_Packer (el mismo empaquetado que se puede hacer al cargar) y, por cada
+// página, guarda la imagen en PNG y una tabla binaria de slices (ver Atlas::Table_Header) con los
+// ids ya calculados, las coordenadas de textura ya normalizadas y los slices ordenados por id para
+// que Atlas los cargue con una sola lectura, sin parsear XML ni reservar memoria por slice.
+//
+// Si hay más de una página, la primera se llama <salida>.atlas/.png y las siguientes
+// <salida>-1.atlas/.png, <salida>-2.atlas/.png, etc. El id de cada imagen es el que se indica antes
+// del '=' o, si no se indica, el nombre del archivo sin carpeta ni extensión (el mismo texto que se
+// pone en ID()).
+//
+// Uso: atlas-builder [--max-size=N] [--padding=N] <salida> [<id>=]<imagen.png> ...
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+#include <basics/Atlas>
+#include <basics/Atlas_Packer>
+#include <basics/fnv>
+
+#include "lodepng.h"
+
+using namespace basics;
+using namespace std;
+
+namespace
+{
+
+    string file_name (const string & path)
+    {
+        size_t slash = path.find_last_of ('/');
+
+        return slash == string::npos ? path : path.substr (slash + 1);
+    }
+
+    string stem (const string & path)
+    {
+        string name = file_name (path);
+        size_t dot  = name.find_last_of ('.');
+
+        return dot == string::npos ? name : name.substr (0, dot);
+    }
+
+    bool write_table (const string & path, const string & texture_name, const Atlas_Packer::Page & page, vector< Atlas_Packer::Placement > placements)
+    {
+        sort
+        (
+            placements.begin (), placements.end (),
+            [] (const Atlas_Packer::Placement & a, const Atlas_Packer::Placement & b) { return a.id < b.id; }
+        );
+
+        // El nombre de la textura acaba en cero y se rellena hasta múltiplo de 4 para que los
+        // registros que le siguen queden alineados:
+
+        vector< char > name(texture_name.begin (), texture_name.end ());
+
+        do name.push_back (0); while (name.size () % 4 != 0);
+
+        Atlas::Table_Header header{ { 'A', 'T', 'L', 'S' }, Atlas::table_version, uint32_t(placements.size ()), uint32_t(name.size ()) };
+
+        vector< Atlas::Table_Record > records;
+
+        float width  = float(page.get_width  ());
+        float height = float(page.get_height ());
+
+        for (const Atlas_Packer::Placement & placement : placements)
+        {
+            float left   = float(placement.x);
+            float bottom = float(placement.y);
+            float right  = left   + placement.width;
+            float top    = bottom + placement.height;
+
+            records.push_back
+            ({
+                placement.id,
+                left,         right,         bottom,          top,
+                float(placement.width), float(placement.height),
+                left / width, right / width, bottom / height, top / height
+            });
+        }
+
+        FILE * file = std::fopen (path.c_str (), "wb");
+
+        if (!file) return false;
+
+        bool written =
+            std::fwrite (&header,        sizeof(header),                 1,              file) == 1           &&
+            std::fwrite (name.data (),   1,                              name.size (),   file) == name.size () &&
+            std::fwrite (records.data (), sizeof(Atlas::Table_Record),   records.size (), file) == records.size ();
+
+        return std::fclose (file) == 0 && written;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    Atlas_Packer::Options options  = Atlas_Packer::default_options;
+    int                   argument = 1;
+
+    for ( ; argument < number_of_arguments && std::strncmp (arguments[argument], "--", 2) == 0; ++argument)
+    {
+        if (std::strncmp (arguments[argument], "--max-size=", 11) == 0)
+        {
+            options.max_width = options.max_height = unsigned(std::strtoul (arguments[argument] + 11, nullptr, 10));
+        }
+        else if (std::strncmp (arguments[argument], "--padding=", 10) == 0)
+        {
+            options.padding = unsigned(std::strtoul (arguments[argument] + 10, nullptr, 10));
+        }
+        else
+        {
+            std::fprintf (stderr, "unknown option %s\n", arguments[argument]);
+            return 1;
+        }
+    }
+
+    if (number_of_arguments - argument < 2)
+    {
+        std::fprintf (stderr, "usage: atlas-builder [--max-size=N] [--padding=N] <output> [<id>=]<image.png> ...\n");
+        return 1;
+    }
+
+    string output = arguments[argument++];
+
+    Atlas_Packer  packer(options);
+    set< Id >     ids;
+
+    for ( ; argument < number_of_arguments; ++argument)
+    {
+        string image  = arguments[argument];
+        size_t equals = image.find ('=');
+        string name   = equals == string::npos ? stem (image) : image.substr (0, equals);
+        string path   = equals == string::npos ? image        : image.substr (equals + 1);
+        Id     id     = fnv32 (name);
+
+        if (!ids.insert (id).second)
+        {
+            std::fprintf (stderr, "duplicated id %s\n", name.c_str ());
+            return 1;
+        }
+
+        packer.add (id, path);
+    }
+
+    vector< Atlas_Packer::Page      > pages;
+    vector< Atlas_Packer::Placement > placements;
+
+    if (!packer.pack (pages, placements))
+    {
+        return 1;
+    }
+
+    for (unsigned index = 0; index < pages.size (); ++index)
+    {
+        string base = index == 0 ? output : output + '-' + to_string (index);
+
+        vector< Atlas_Packer::Placement > page_placements;
+
+        for (const Atlas_Packer::Placement & placement : placements)
+        {
+            if (placement.page == index) page_placements.push_back (placement);
+        }
+
+        Atlas_Packer::Page & page = pages[index];
+
+        // Las filas se guardan sin filtro: el PNG ocupa algo más, pero se descomprime antes al cargarlo
+        // (y en el APK se vuelve a comprimir):
+
+        lodepng::State  state;
+        vector< byte >  png;
+
+        state.encoder.filter_strategy = LFS_ZERO;
+
+        unsigned error = lodepng::encode (png, static_cast< byte * >(page), page.get_width (), page.get_height (), state);
+
+        if (!error) error = lodepng::save_file (png, base + ".png");
+
+        if (error)
+        {
+            std::fprintf (stderr, "can't write %s.png: %s\n", base.c_str (), lodepng_error_text (error));
+            return 1;
+        }
+
+        if (!write_table (base + ".atlas", file_name (base + ".png"), page, page_placements))
+        {
+            std::fprintf (stderr, "can't write %s.atlas\n", base.c_str ());
+            return 1;
+        }
+
+        std::printf ("%s.png: %ux%u, %zu slices\n", base.c_str (), page.get_width (), page.get_height (), page_placements.size ());
+    }
+
+    return 0;
+}
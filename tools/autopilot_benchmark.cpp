@@ -0,0 +1,119 @@
+/*
+ * AUTOPILOT BENCHMARK
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+// Juega con el piloto automático (Autopilot) sin dispositivo ni contexto gráfico y muestra cuántas
+// decisiones toma por segundo, cuántos pasos de simulación hace al buscar y cuánto sobrevive en
+// comparación con un controlador sencillo que sube cuando está por debajo de la mitad de la
+// pantalla. Sirve también como carga de trabajo para medir el núcleo de la simulación.
+//
+// Uso: autopilot-benchmark [pasos] [pasos de anticipación] [hilos]
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <basics/Timer>
+
+#include "Autopilot.hpp"
+
+using namespace basics;
+using namespace flythecopter;
+
+namespace
+{
+
+    struct Results
+    {
+        unsigned games;
+        unsigned longest;           // Pasos de la partida más larga
+        double   seconds;
+    };
+
+    // Juega 'ticks' pasos decidiendo con 'decide'. Al perder se vuelve a empezar.
+    Results play (unsigned ticks, const std::function< bool (const Game_Simulation &) > & decide)
+    {
+        const float time = 1.f / Game_Simulation::tick_rate;
+
+        Game_Simulation simulation({ 1280.f, 720.f });
+        Results         results{};
+        unsigned        length = 0;
+
+        simulation.set_seed       (1);
+        simulation.create_sprites ({ 166.f, 66.f });
+        simulation.restart        ();
+        simulation.start_playing  ();
+
+        Timer timer;
+
+        for (unsigned tick = 0; tick < ticks; ++tick)
+        {
+            simulation.set_flying (decide (simulation));
+            simulation.step       (time);
+
+            length++;
+
+            if (simulation.get_gameplay () == Game_Simulation::GAME_OVER)
+            {
+                if (length > results.longest) results.longest = length;
+
+                results.games++;
+                length = 0;
+
+                simulation.restart       ();
+                simulation.start_playing ();
+            }
+        }
+
+        if (length > results.longest) results.longest = length;
+
+        results.seconds = timer.get_elapsed_seconds< double > ();
+
+        return results;
+    }
+
+    void print (const char * name, unsigned ticks, const Results & results)
+    {
+        std::printf
+        (
+            "%-11s %8u %14.1f %14.1f\n",
+            name,
+            results.games,
+            ticks / double(results.games + 1) / Game_Simulation::tick_rate,
+            results.longest / double(Game_Simulation::tick_rate)
+        );
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    unsigned ticks     = number_of_arguments > 1 ? unsigned(std::strtoul (arguments[1], nullptr, 10)) :  36000u;
+    unsigned lookahead = number_of_arguments > 2 ? unsigned(std::strtoul (arguments[2], nullptr, 10)) :     30u;
+    unsigned threads   = number_of_arguments > 3 ? unsigned(std::strtoul (arguments[3], nullptr, 10)) :      0u;
+
+    if (ticks == 0) ticks = 1;
+
+    Autopilot autopilot({ 1280.f, 720.f }, { 166.f, 66.f }, lookahead, threads);
+
+    Results simple = play (ticks, [] (const Game_Simulation & simulation) { return simulation.get_player_bounds ().bottom < 330.f; });
+    Results pilot  = play (ticks, [&] (const Game_Simulation & simulation) { return autopilot.decide (simulation); });
+
+    double decisions_per_second = autopilot.get_decisions_per_second ();
+
+    std::printf ("%u ticks (%.1f simulated minutes), %u branches of %u ticks\n\n", ticks, ticks / 60.0 / Game_Simulation::tick_rate, autopilot.get_branch_count (), lookahead);
+    std::printf ("%-11s %8s %14s %14s\n", "controller", "games", "mean game (s)", "longest (s)");
+
+    print ("simple",    ticks, simple);
+    print ("autopilot", ticks, pilot );
+
+    std::printf ("\ndecisions per second:     %.0f (%.1f us each)\n", decisions_per_second, 1e6 / decisions_per_second);
+    std::printf ("branch ticks per second:  %.0f\n", decisions_per_second * autopilot.get_branch_count () * lookahead);
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * BATCH BENCHMARK
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+// Mide cómo escala Simulation_Batch con el número de hilos simulando muchas partidas a la vez. El
+// jugador lo lleva un controlador sencillo que sube cuando está por debajo de la mitad de la
+// pantalla. Como cada partida tiene su semilla, el número de partidas jugadas debe ser el mismo
+// con cualquier número de hilos.
+//
+// Uso: batch-benchmark [partidas] [pasos]
+
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <basics/Timer>
+
+#include "Simulation_Batch.hpp"
+
+using namespace basics;
+using namespace flythecopter;
+
+int main (int number_of_arguments, char * arguments[])
+{
+    unsigned instances = number_of_arguments > 1 ? unsigned(std::strtoul (arguments[1], nullptr, 10)) : 1024u;
+    unsigned ticks     = number_of_arguments > 2 ? unsigned(std::strtoul (arguments[2], nullptr, 10)) : 3600u;
+    unsigned cores     = std::thread::hardware_concurrency ();
+
+    if (instances == 0) instances = 1;
+    if (cores     == 0) cores     = 1;
+
+    std::printf ("%u instances, %u ticks each, %u hardware threads\n\n", instances, ticks, cores);
+    std::printf ("%8s %16s %10s %10s\n", "threads", "ticks/s", "speedup", "games");
+
+    double   single_thread = 0.0;
+    unsigned reference     = 0;
+
+    for (unsigned threads = 1; threads <= cores * 2; threads *= 2)
+    {
+        Simulation_Batch batch(instances, { 1280.f, 720.f }, { 166.f, 66.f }, 1, threads);
+
+        auto controller = [] (unsigned, const Game_Simulation & simulation)
+        {
+            return simulation.get_player_bounds ().bottom < 330.f;
+        };
+
+        Timer timer;
+
+        // Se avanza en tramos de un segundo simulado, como haría una herramienta que revisa las partidas entre tramos:
+
+        for (unsigned done = 0; done < ticks; done += Game_Simulation::tick_rate)
+        {
+            unsigned step = ticks - done < unsigned(Game_Simulation::tick_rate) ? ticks - done : unsigned(Game_Simulation::tick_rate);
+
+            batch.step (1.f / Game_Simulation::tick_rate, step, controller);
+        }
+
+        double   seconds = timer.get_elapsed_seconds< double > ();
+        double   rate    = double(instances) * ticks / seconds;
+        unsigned games   = 0;
+
+        for (unsigned instance = 0; instance < instances; ++instance)
+        {
+            games += batch.get_games (instance);
+        }
+
+        if (threads == 1)
+        {
+            single_thread = rate;
+            reference     = games;
+        }
+
+        std::printf ("%8u %16.0f %10.2f %10u\n", batch.get_thread_count (), rate, rate / single_thread, games);
+
+        if (games != reference)
+        {
+            std::printf ("ERROR: the result depends on the number of threads\n");
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
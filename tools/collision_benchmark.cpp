@@ -0,0 +1,176 @@
+/*
+ * COLLISION BENCHMARK
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+// Mide cómo escala la detección de colisiones con el número de obstáculos comparando la búsqueda
+// lineal de Sprite_Store con el índice de barrido de Collision_Index. Los obstáculos se reparten
+// con densidad constante a lo largo de un pasillo cuya longitud crece con su número, igual que
+// ocurre en el juego a medida que avanza, y se desplazan hacia la izquierda entre fotogramas.
+// También compara la prueba de una caja contra todas con un bucle escalar y con find_overlap_mask().
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <basics/Timer>
+
+#include "Collision_Index.hpp"
+#include "Overlap_Kernel.hpp"
+#include "Sprite_Store.hpp"
+
+using namespace basics;
+using namespace flythecopter;
+
+namespace
+{
+
+    const float frame_time = 1.f / 60.f;
+
+    // Las pruebas guardan aquí su resultado en cada repetición para que el compilador no pueda
+    // eliminarlas ni sacarlas del bucle de medida:
+    volatile unsigned sink;
+
+    void populate (Sprite_Store & obstacles, unsigned count, std::mt19937 & random)
+    {
+        std::uniform_real_distribution< float > x(0.f, count * 120.f);
+        std::uniform_real_distribution< float > y(50.f, 720.f);
+        std::uniform_real_distribution< float > h(100.f, 300.f);
+
+        for (unsigned index = 0; index < count; ++index)
+        {
+            Sprite_Store::Handle obstacle = obstacles.create (0, { 75.f, h (random) });
+
+            obstacles.set_anchor   (obstacle, CENTER | RIGHT);
+            obstacles.set_position (obstacle, { x (random), y (random) });
+            obstacles.set_speed_x  (obstacle, -400.f);
+        }
+    }
+
+    // Repite 'function' hasta acumular algo más de 0,2 s y devuelve los microsegundos por repetición.
+    template< typename FUNCTION >
+    double measure (FUNCTION function)
+    {
+        unsigned repetitions = 0;
+        Timer    timer;
+
+        do
+        {
+            function ();
+            repetitions++;
+        }
+        while (timer.get_elapsed_seconds< double > () < .2);
+
+        return timer.get_elapsed_seconds< double > () * 1e6 / repetitions;
+    }
+
+}
+
+int main ()
+{
+    const unsigned counts[] = { 10, 100, 1000, 10000, 100000 };
+
+    std::printf ("%10s %14s %14s %14s %14s %14s %14s %14s %10s %10s\n",
+                 "obstacles", "linear (us)", "scalar 1xN", "kernel 1xN", "update (us)", "query (us)", "pairs (us)", "n^2 pairs (us)", "pairs", "hits");
+
+    for (unsigned count : counts)
+    {
+        std::mt19937    random(count);
+        Sprite_Store    obstacles(count);
+        Collision_Index index;
+
+        index.reserve (count);
+
+        populate (obstacles, count, random);
+
+        // La primera actualización del índice ordena todo desde cero. Las siguientes aprovechan el orden anterior:
+
+        index.update (obstacles);
+
+        Sprite_Store::Bounds player{ 220.f, 340.f, 292.f, 380.f };
+
+        std::vector< Collision_Index::Pair > pairs;
+
+        pairs.reserve (count * 4);
+
+        double linear = measure ([&] { sink = obstacles.find_overlap (player); });
+        // Prueba de una caja contra todas sobre arrays empaquetados, sin salir al encontrar la primera:
+
+        std::vector< float    > left(count), bottom(count), right(count), top(count);
+        std::vector< uint32_t > mask(overlap_mask_words (count));
+
+        for (unsigned index = 0; index < count; ++index)
+        {
+            Sprite_Store::Bounds bounds = obstacles.get_bounds_at (index);
+
+            left[index] = bounds.left; bottom[index] = bounds.bottom; right[index] = bounds.right; top[index] = bounds.top;
+        }
+
+        Packed_Bounds packed{ left.data (), bottom.data (), right.data (), top.data () };
+
+        double scalar = measure
+        ([&]
+        {
+            unsigned hits = 0;
+
+            std::fill (mask.begin (), mask.end (), 0u);
+
+            for (unsigned index = 0; index < count; ++index)
+            {
+                if (Sprite_Store::overlap (player, { left[index], bottom[index], right[index], top[index] }))
+                {
+                    mask[index / 32] |= 1u << (index % 32);
+                    hits++;
+                }
+            }
+
+            sink = hits;
+        });
+
+        double kernel = measure ([&] { sink = find_overlap_mask (player, packed, count, mask.data ()); });
+
+        // Número de obstáculos que tocan al jugador (sirve también para ver que las pruebas tienen algo que hacer):
+
+        unsigned hits = find_overlap_mask (player, packed, count, mask.data ());
+
+        double update = measure ([&] { obstacles.update (frame_time); index.update (obstacles); });
+        double query  = measure ([&] { sink = index.find_overlap (player); });
+        double sweep  = measure ([&] { pairs.clear (); index.find_pairs (pairs); });
+
+        // La comprobación de todas las parejas contra todas es cuadrática y se omite a partir de 10000:
+
+        double brute = -1.0;
+
+        if (count <= 10000)
+        {
+            brute = measure
+            ([&]
+            {
+                pairs.clear ();
+
+                for (unsigned a = 0; a < count; ++a)
+                {
+                    Sprite_Store::Bounds bounds = obstacles.get_bounds_at (a);
+
+                    for (unsigned b = a + 1; b < count; ++b)
+                    {
+                        if (Sprite_Store::overlap (bounds, obstacles.get_bounds_at (b)))
+                        {
+                            pairs.push_back ({ a, b });
+                        }
+                    }
+                }
+            });
+        }
+
+        std::printf ("%10u %14.2f %14.2f %14.2f %14.2f %14.2f %14.2f %14.2f %10u %10u\n",
+                     count, linear, scalar, kernel, update, query, sweep, brute, unsigned(pairs.size ()), hits);
+    }
+
+    return 0;
+}
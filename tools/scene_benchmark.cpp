@@ -0,0 +1,225 @@
+/*
+ * SCENE BENCHMARK
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+// Ejecuta las escenas del juego completas (Intro_Scene -> Menu_Scene -> Game_Scene) mediante el
+// Director, sin pantalla ni GPU: la aplicación, la ventana y el contexto gráfico son los del backend
+// headless de basics, que carga los assets desde la carpeta del proyecto y solo cuenta lo que se
+// dibuja. El reloj es virtual (cada fotograma avanza el mismo tiempo) y las pulsaciones siguen un
+// guion grabado con Input_Recorder y reproducido con Director::play(), así que con la misma semilla
+// cada ejecución recorre exactamente los mismos fotogramas. Muestra la duración real de los
+// fotogramas (la que mide Frame_Statistics) y el trabajo enviado al canvas.
+//
+// Con "autopilot" como primer argumento juega directamente Game_Scene con el piloto automático en
+// fotogramas de 1/15 s, de modo que el Director hace varios pasos de simulación por fotograma, y
+// falla si la escena deja de actualizarse antes de tiempo (por ejemplo, porque un toque del piloto
+// automático que llega después de perder la ha cambiado por el menú).
+//
+// Uso: scene-benchmark [segundos] [semilla] [carpeta de assets]
+//      scene-benchmark autopilot [segundos] [semilla] [carpeta de assets]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <basics/Director>
+#include <basics/enable>
+#include <basics/headless/Canvas>
+#include <basics/headless/Context>
+#include <basics/headless/Headless>
+#include <basics/Input_Replay>
+#include <basics/Timer>
+
+#include "Game_Scene.hpp"
+#include "Intro_Scene.hpp"
+
+using namespace basics;
+using namespace flythecopter;
+
+namespace
+{
+
+    const float time_step = 1.f / 60.f;
+
+    // Centro de la opción PLAY del menú (ver Menu_Scene::configure_options) y punto en el que se toca
+    // durante la partida (lejos del botón de pausa de la esquina superior derecha):
+
+    const Point2f play_option{ 640.f, 300.f };
+    const Point2f game_touch { 200.f, 360.f };
+
+    Event touch (Id id, const Point2f & where)
+    {
+        Event event(id);
+
+        event.properties[ID(x)] = where[0];
+        event.properties[ID(y)] = where[1];
+
+        return event;
+    }
+
+    // Guion de pulsaciones: se espera a que termine la introducción (7 s), se pulsa PLAY, se empieza
+    // la partida cuando ha terminado de cargar y a partir de ahí se alterna entre volar y caer cada
+    // cuarto de segundo. Al perder, la siguiente pulsación vuelve al menú, donde el punto tocado cae
+    // sobre PLAY, de modo que se juegan varias partidas seguidas.
+
+    Input_Replay::Buffer create_script (unsigned frames, uint64_t seed)
+    {
+        const unsigned menu_frame  = unsigned( 8.f / time_step);
+        const unsigned start_frame = unsigned(10.f / time_step);
+        const unsigned toggle      = unsigned(.25f / time_step);
+
+        Input_Recorder recorder(seed);
+
+        for (unsigned frame = 0; frame < frames; ++frame)
+        {
+            recorder.begin_frame (time_step);
+
+            if (frame == menu_frame)
+            {
+                recorder.add_event (touch (ID(touch-started), play_option));
+                recorder.add_event (touch (ID(touch-ended  ), play_option));
+            }
+            else if (frame >= start_frame && (frame - start_frame) % toggle == 0)
+            {
+                bool flying = (frame - start_frame) / toggle % 2 == 0;
+
+                recorder.add_event (touch (flying ? ID(touch-started) : ID(touch-ended), game_touch));
+            }
+
+            recorder.end_frame ();
+        }
+
+        return recorder.get_buffer ();
+    }
+
+    // Game_Scene que cuenta las veces que el Director la actualiza:
+
+    class Counted_Game_Scene : public Game_Scene
+    {
+    public:
+
+        unsigned updates = 0;
+
+        void update (float time) override
+        {
+            Game_Scene::update (time);
+
+            updates++;
+        }
+    };
+
+    int soak_autopilot (float seconds, uint64_t seed)
+    {
+        const float    frame_step = 1.f / 15.f;
+        const unsigned frames     = unsigned(seconds / frame_step);
+
+        director.set_seed       (seed);
+        director.set_time_step  (frame_step);
+        director.set_frame_limit (frames);
+        director.get_frame_statistics ().set_logging (false);
+
+        std::shared_ptr< Counted_Game_Scene > scene(new Counted_Game_Scene);
+
+        scene->set_autopilot (true);
+
+        director.run_scene (scene);
+
+        // Cada fotograma consume frame_step en pasos fijos (puede quedar uno pendiente del último):
+
+        unsigned expected = unsigned(frames * frame_step / scene->get_fixed_step ());
+
+        std::printf ("autopilot:   %u frames of %.0f ms, %u updates of %u expected, %u games restarted\n",
+                     frames, frame_step * 1e3, scene->updates, expected, scene->get_autopilot_games ());
+
+        if (scene->updates + 1 < expected)
+        {
+            std::printf ("ERROR: the game scene stopped being updated before the end\n");
+            return 1;
+        }
+
+        if (scene->get_autopilot_games () == 0)
+        {
+            std::printf ("ERROR: the autopilot didn't lose any game, so nothing was checked (try more seconds)\n");
+            return 1;
+        }
+
+        return 0;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    bool autopilot = number_of_arguments > 1 && std::strcmp (arguments[1], "autopilot") == 0;
+
+    if (autopilot)
+    {
+        number_of_arguments--;
+        arguments++;
+    }
+
+    float    seconds = number_of_arguments > 1 ? float(std::strtod   (arguments[1], nullptr    )) : 60.f;
+    uint64_t seed    = number_of_arguments > 2 ?       std::strtoull (arguments[2], nullptr, 10)  :  1u;
+
+    headless::set_asset_path (number_of_arguments > 3 ? arguments[3] : FLYTHECOPTER_ASSETS_PATH);
+
+    enable< Headless > ();
+
+    director.set_graphics_context_factory (headless::Context::create);
+
+    if (autopilot) return soak_autopilot (seconds, seed);
+
+    const unsigned frames = unsigned(seconds / time_step);
+
+    director.set_time_step                (time_step);
+    director.set_frame_limit              (frames);
+    director.get_frame_statistics ().set_logging (false);
+
+    if (!director.play (create_script (frames, seed)))
+    {
+        std::fprintf (stderr, "invalid input script\n");
+        return 1;
+    }
+
+    Timer timer;
+
+    director.run_scene (std::shared_ptr< Scene >(new Intro_Scene));
+
+    double real_seconds = timer.get_elapsed_seconds< double > ();
+
+    Frame_Statistics::Summary summary = director.get_frame_statistics ().get_summary ();
+
+    std::printf ("frames:      %u (%.1f virtual s)\n", frames, double(frames * time_step));
+    std::printf ("real time:   %.3f s (%.0f frames/s)\n", real_seconds, frames / real_seconds);
+    std::printf
+    (
+        "last %u frames: mean %.3f ms  p50 %.3f ms  p95 %.3f ms  p99 %.3f ms  max %.3f ms\n",
+        summary.frames, summary.mean * 1e3, summary.p50 * 1e3, summary.p95 * 1e3, summary.p99 * 1e3, summary.max * 1e3
+    );
+
+    Graphics_Context::Accessor context = director.lock_graphics_context ();
+
+    if (context)
+    {
+        headless::Canvas * canvas = context->get_renderer< headless::Canvas > (ID(canvas));
+
+        if (canvas)
+        {
+            const headless::Canvas::Totals & totals = canvas->get_totals ();
+
+            std::printf
+            (
+                "canvas:      %.1f draw calls/frame, %.1f vertices/frame\n",
+                double(totals.draw_calls) / totals.frames, double(totals.vertices) / totals.frames
+            );
+        }
+    }
+
+    return 0;
+}
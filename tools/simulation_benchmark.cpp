@@ -0,0 +1,468 @@
+/*
+ * SIMULATION BENCHMARK
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+// Ejecuta la lógica de Game_Scene (Game_Simulation) sin dispositivo ni contexto gráfico. El tiempo
+// es virtual (cada paso avanza 1 / tick_rate segundos) y las pulsaciones siguen un guion fijo, así
+// que con la misma semilla cada ejecución simula exactamente la misma partida. Muestra los pasos
+// por segundo, el tiempo medio de cada fase del paso y las reservas de memoria hechas al simular.
+// También mide cuánto cuesta guardar y restaurar un Game_Simulation::Snapshot y comprueba que,
+// tras volver atrás, la simulación repite exactamente los mismos pasos, que con un paso muy largo
+// el jugador no atraviesa un obstáculo sin chocar y que con un paso muy largo dentro de la cueva el
+// choque con el suelo se sitúa en el mismo momento que con pasos cortos.
+//
+// Uso: simulation-benchmark [pasos] [semilla]
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "Game_Simulation.hpp"
+
+using namespace flythecopter;
+
+// Se cuentan todas las reservas de memoria dinámica del programa:
+
+namespace
+{
+    std::atomic< unsigned long > allocation_count(0);
+}
+
+void * operator new (std::size_t size)
+{
+    allocation_count++;
+
+    if (void * memory = std::malloc (size ? size : 1)) return memory;
+
+    throw std::bad_alloc();
+}
+
+void operator delete (void * memory) noexcept
+{
+    std::free (memory);
+}
+
+void operator delete (void * memory, std::size_t) noexcept
+{
+    std::free (memory);
+}
+
+namespace
+{
+
+    typedef std::chrono::steady_clock Clock;
+
+    // Guion de pulsaciones que se repite en bucle: cuántos pasos dura cada tramo y si se toca la pantalla.
+    // Subiendo a 350 px/s y cayendo a 300 px/s el jugador se mantiene más o menos a la misma altura.
+
+    struct Script_Step
+    {
+        unsigned ticks;
+        bool     touching;
+    };
+
+    const Script_Step script[] =
+    {
+        { 18, true  }, { 21, false }, { 12, true  }, { 14, false },
+        { 30, true  }, { 35, false }, {  6, true  }, {  7, false },
+    };
+
+    const unsigned script_length = sizeof(script) / sizeof(Script_Step);
+
+    // Hace avanzar el guion un paso y devuelve si el usuario está tocando la pantalla.
+    struct Script_Player
+    {
+        unsigned step = 0;
+        unsigned tick = 0;
+
+        bool next ()
+        {
+            if (++tick > script[step].ticks)
+            {
+                tick = 1;
+                step = (step + 1) % script_length;
+            }
+
+            return script[step].touching;
+        }
+    };
+
+    // Tiempo acumulado en cada fase del paso:
+
+    enum Phase { MOVE_SPRITES, SCROLL_TERRAIN, SPAWN_OBSTACLES, MOVE_OBSTACLES, UPDATE_USER, CHECK_COLLISIONS, PHASE_COUNT };
+
+    const char * phase_names[PHASE_COUNT] =
+    {
+        "move sprites", "scroll terrain", "spawn obstacles", "move obstacles", "update user", "check collisions"
+    };
+
+    struct Results
+    {
+        double        seconds;
+        double        phase_seconds[PHASE_COUNT];
+        unsigned      games;
+        unsigned long allocations;
+        unsigned long pool_allocations;                     // Reservas del pool de obstáculos en pasos jugando
+    };
+
+    /*
+     * Simula 'ticks' pasos. Cuando el jugador pierde se vuelve a empezar. Si 'profile' es true se mide
+     * cada fase por separado (lo que añade el coste de leer el reloj varias veces por paso).
+     */
+    Results run (unsigned ticks, uint64_t seed, bool profile)
+    {
+        const float time = 1.f / Game_Simulation::tick_rate;
+
+        Game_Simulation simulation({ 1280.f, 720.f });
+        Script_Player   script_player;
+        Results         results{};
+
+        simulation.set_seed       (seed);
+        simulation.set_cave       (true);
+        simulation.create_sprites ({ 166.f, 66.f });          // Tamaño de game-scene/helicoptero.png
+        simulation.restart        ();
+        simulation.start_playing  ();
+
+        unsigned long allocations_before = allocation_count;
+        Clock::time_point start = Clock::now ();
+
+        for (unsigned tick = 0; tick < ticks; ++tick)
+        {
+            bool     playing          = simulation.get_gameplay () == Game_Simulation::PLAYING;
+            unsigned pool_allocations = simulation.get_obstacles ().get_allocation_count ();
+
+            simulation.set_flying (script_player.next ());
+
+            if (!profile)
+            {
+                simulation.step (time);
+            }
+            else
+            {
+                Clock::time_point t0 = Clock::now ();
+
+                simulation.move_sprites (time);
+
+                Clock::time_point t1 = Clock::now (), t2 = t1, t3 = t1, t4 = t1;
+
+                if (simulation.get_gameplay () == Game_Simulation::PLAYING)
+                {
+                    simulation.scroll_terrain  (time); t2 = Clock::now ();
+                    simulation.spawn_obstacles (time); t3 = Clock::now ();
+                    simulation.move_obstacles  (time); t4 = Clock::now ();
+                }
+
+                simulation.update_user      (); Clock::time_point t5 = Clock::now ();
+                simulation.check_collisions (); Clock::time_point t6 = Clock::now ();
+
+                results.phase_seconds[MOVE_SPRITES    ] += std::chrono::duration< double >(t1 - t0).count ();
+                results.phase_seconds[SCROLL_TERRAIN  ] += std::chrono::duration< double >(t2 - t1).count ();
+                results.phase_seconds[SPAWN_OBSTACLES ] += std::chrono::duration< double >(t3 - t2).count ();
+                results.phase_seconds[MOVE_OBSTACLES  ] += std::chrono::duration< double >(t4 - t3).count ();
+                results.phase_seconds[UPDATE_USER     ] += std::chrono::duration< double >(t5 - t4).count ();
+                results.phase_seconds[CHECK_COLLISIONS] += std::chrono::duration< double >(t6 - t5).count ();
+            }
+
+            if (playing) results.pool_allocations += simulation.get_obstacles ().get_allocation_count () - pool_allocations;
+
+            if (simulation.get_gameplay () == Game_Simulation::GAME_OVER)
+            {
+                results.games++;
+
+                simulation.restart       ();
+                simulation.start_playing ();
+            }
+        }
+
+        results.seconds     = std::chrono::duration< double >(Clock::now () - start).count ();
+        results.allocations = allocation_count - allocations_before;
+
+        return results;
+    }
+
+    /*
+     * Mide el coste de guardar y restaurar una copia del estado y comprueba que volver atrás y
+     * repetir los mismos pasos lleva exactamente al mismo estado.
+     */
+    bool check_rollback (uint64_t seed, double & save_ns, double & restore_ns)
+    {
+        const float    time     = 1.f / Game_Simulation::tick_rate;
+        const unsigned replayed = 600;
+
+        Game_Simulation simulation({ 1280.f, 720.f });
+        Script_Player   script_player;
+
+        simulation.set_seed       (seed);
+        simulation.set_cave       (true);
+        simulation.create_sprites ({ 166.f, 66.f });
+        simulation.restart        ();
+        simulation.start_playing  ();
+
+        // Se avanza hasta que haya varios obstáculos en pantalla:
+
+        for (unsigned tick = 0; tick < 240 && simulation.get_gameplay () == Game_Simulation::PLAYING; ++tick)
+        {
+            simulation.set_flying (script_player.next ());
+            simulation.step       (time);
+        }
+
+        Game_Simulation::Snapshot start, first, second;
+
+        const unsigned repetitions = 100000;
+
+        Clock::time_point t0 = Clock::now ();
+
+        for (unsigned repetition = 0; repetition < repetitions; ++repetition) simulation.save (start);
+
+        Clock::time_point t1 = Clock::now ();
+
+        for (unsigned repetition = 0; repetition < repetitions; ++repetition) simulation.restore (start);
+
+        Clock::time_point t2 = Clock::now ();
+
+        save_ns    = std::chrono::duration< double, std::nano >(t1 - t0).count () / repetitions;
+        restore_ns = std::chrono::duration< double, std::nano >(t2 - t1).count () / repetitions;
+
+        // Se juega un tramo, se vuelve atrás y se juega otra vez con las mismas pulsaciones:
+
+        Script_Player saved_script = script_player;
+
+        for (unsigned pass = 0; pass < 2; ++pass)
+        {
+            simulation.restore (start);
+
+            script_player = saved_script;
+
+            for (unsigned tick = 0; tick < replayed; ++tick)
+            {
+                simulation.set_flying (script_player.next ());
+                simulation.step       (time);
+            }
+
+            Game_Simulation::Snapshot & end = pass == 0 ? first : second;
+
+            std::memset    (&end, 0, sizeof(end));
+            simulation.save (end);
+        }
+
+        return std::memcmp (&first, &second, sizeof(first)) == 0;
+    }
+
+    /*
+     * Coloca un obstáculo justo delante del jugador y avanza un único paso de 0,75 s en el que el
+     * obstáculo (75 px a 400 px/s) pasa de estar a su derecha a estar a su izquierda. Al final del
+     * paso las cajas no se solapan, así que solo la detección continua puede ver el choque.
+     */
+    bool check_tunnelling (float & impact_time)
+    {
+        const float time = .75f;
+
+        Game_Simulation simulation({ 1280.f, 720.f });
+
+        simulation.create_sprites ({ 166.f, 66.f });
+        simulation.restart        ();
+        simulation.start_playing  ();
+
+        Game_Simulation::Snapshot snapshot;
+
+        simulation.save (snapshot);
+
+        Sprite_Store::Bounds player = simulation.get_player_bounds ();
+
+        snapshot.player_speed_y = 0.f;
+        snapshot.obstacle_count = 1;
+        snapshot.obstacles[0]   = { player.right + 85.f, (player.bottom + player.top) / 2.f, 75.f, 200.f, -400.f };
+
+        simulation.restore (snapshot);
+        simulation.step    (time);
+
+        impact_time = simulation.get_impact_time ();
+
+        // El obstáculo debe haberse quedado tocando al jugador:
+
+        float obstacle_left = simulation.get_obstacles ().get_lefts ()[0];
+
+        return simulation.get_gameplay () == Game_Simulation::GAME_OVER
+            && std::abs (obstacle_left - simulation.get_player_bounds ().right) < .01f;
+    }
+
+    /*
+     * Deja caer al jugador dentro de la cueva y compara el momento del choque que se obtiene con un
+     * único paso de 0,75 s (en el que la cueva avanza 300 px, unas 19 columnas, y luego tiene que
+     * retroceder hasta el momento del choque) con el que se obtiene avanzando en pasos de 1 ms. Se
+     * prueba desde varios puntos de una partida en la que el jugador se mantiene unos 80 px por
+     * encima del suelo, de modo que al caer choca hacia la primera mitad del paso largo.
+     */
+    bool check_cave_rewind (uint64_t seed, float & long_time, float & short_time)
+    {
+        const float time       = 1.f / Game_Simulation::tick_rate;
+        const float long_step  = .75f;
+        const float short_step = .001f;
+
+        Game_Simulation simulation({ 1280.f, 720.f });
+
+        simulation.set_seed       (seed);
+        simulation.set_cave       (true);
+        simulation.create_sprites ({ 166.f, 66.f });
+        simulation.restart        ();
+        simulation.start_playing  ();
+
+        Game_Simulation::Snapshot start;
+
+        for (unsigned attempt = 0; attempt < 60; ++attempt)
+        {
+            // Se juega cerca del suelo para que la cueva cambie (la primera vez 10 s, hasta que llega al
+            // jugador la parte que no es recta, y después medio segundo). Si un obstáculo acaba la
+            // partida se empieza otra:
+
+            unsigned ticks = attempt == 0 ? Game_Simulation::tick_rate * 10 : Game_Simulation::tick_rate / 2;
+
+            for (unsigned tick = 0; tick < ticks; ++tick)
+            {
+                Sprite_Store::Bounds player = simulation.get_player_bounds ();
+                float                floor, ceiling;
+
+                simulation.get_terrain ().get_gap ((player.left + player.right) / 2.f, floor, ceiling);
+
+                simulation.set_flying (player.bottom < floor + 80.f);
+                simulation.step       (time);
+
+                if (simulation.get_gameplay () == Game_Simulation::GAME_OVER)
+                {
+                    simulation.restart       ();
+                    simulation.start_playing ();
+                }
+            }
+
+            // Desde aquí el jugador cae sin obstáculos:
+
+            simulation.save (start);
+
+            start.flying         = 0;
+            start.player_speed_y = -300.f;
+            start.obstacle_count = 0;
+
+            Game_Simulation test({ 1280.f, 720.f });
+
+            test.create_sprites ({ 166.f, 66.f });
+            test.restore        (start);
+            test.step           (long_step);
+
+            if (test.get_gameplay () != Game_Simulation::GAME_OVER) continue;
+
+            long_time = test.get_impact_time () * long_step;
+
+            // Al chocar la cueva retrocede hasta donde estaba en ese momento. Se guarda su forma para
+            // compararla con la que queda con los pasos cortos:
+
+            const unsigned columns = 1280 / unsigned(Cave_Terrain::column_width) + 1;
+
+            float long_floors[columns], long_ceilings[columns];
+
+            for (unsigned column = 0; column < columns; ++column)
+            {
+                test.get_terrain ().get_gap (column * Cave_Terrain::column_width, long_floors[column], long_ceilings[column]);
+            }
+
+            test.restore (start);
+
+            for (short_time = 0.f; short_time < long_step && test.get_gameplay () == Game_Simulation::PLAYING; short_time += short_step)
+            {
+                test.step (short_step);
+            }
+
+            // El choque se ha producido durante el último paso corto:
+
+            short_time += (test.get_impact_time () - 1.f) * short_step;
+
+            if (std::abs (long_time - short_time) >= 2.f * short_step) return false;
+
+            for (unsigned column = 0; column < columns; ++column)
+            {
+                float floor, ceiling;
+
+                test.get_terrain ().get_gap (column * Cave_Terrain::column_width, floor, ceiling);
+
+                if (std::abs (floor - long_floors[column]) > .5f || std::abs (ceiling - long_ceilings[column]) > .5f) return false;
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    unsigned ticks = number_of_arguments > 1 ? unsigned(std::strtoul  (arguments[1], nullptr, 10)) : 10000000u;
+    uint64_t seed  = number_of_arguments > 2 ? uint64_t(std::strtoull (arguments[2], nullptr, 10)) : 1u;
+
+    if (ticks == 0) ticks = 1;
+
+    Results plain    = run (ticks, seed, false);
+    Results profiled = run (ticks, seed, true );
+
+    double  save_ns, restore_ns;
+    bool    rollback = check_rollback (seed, save_ns, restore_ns);
+
+    float   impact_time;
+    bool    swept    = check_tunnelling (impact_time);
+
+    float   long_time = 0.f, short_time = 0.f;
+    bool    rewound  = check_cave_rewind (seed, long_time, short_time);
+
+    std::printf ("ticks:             %u (%.1f simulated hours)\n", ticks, ticks / double(Game_Simulation::tick_rate) / 3600.0);
+    std::printf ("games:             %u\n", plain.games + 1);
+    std::printf ("ticks per second:  %.0f\n", ticks / plain.seconds);
+    std::printf ("ns per tick:       %.1f\n", plain.seconds * 1e9 / ticks);
+    std::printf ("allocations:       %lu (obstacle pool while playing: %lu)\n", plain.allocations, plain.pool_allocations);
+
+    std::printf ("\nphase timings (profiled run, clock overhead included):\n");
+
+    for (unsigned phase = 0; phase < PHASE_COUNT; ++phase)
+    {
+        std::printf ("  %-17s %8.1f ns/tick\n", phase_names[phase], profiled.phase_seconds[phase] * 1e9 / ticks);
+    }
+
+    std::printf ("\nsnapshot:          %u bytes, save %.1f ns, restore %.1f ns, rollback %s\n",
+                 unsigned(sizeof(Game_Simulation::Snapshot)), save_ns, restore_ns, rollback ? "ok" : "DIVERGED");
+
+    std::printf ("swept collision:   %s (impact at %.1f%% of a 750 ms step)\n", swept ? "ok" : "MISSED", impact_time * 100.f);
+
+    std::printf ("cave collision:    %s (impact after %.1f ms in a 750 ms step, %.1f ms in 1 ms steps)\n",
+                 rewound ? "ok" : "MISPLACED", long_time * 1e3f, short_time * 1e3f);
+
+    if (!rollback || !swept || !rewound) return 1;
+
+    // Mientras se juega no debe reservarse memoria, ni en general ni en el pool de obstáculos:
+
+    if (plain.allocations != 0 || plain.pool_allocations != 0)
+    {
+        std::printf ("\nERROR: the simulation allocated memory while playing\n");
+
+        return 1;
+    }
+
+    // Las dos ejecuciones usan la misma semilla y el mismo guion, así que deben jugar las mismas partidas:
+
+    if (profiled.games != plain.games)
+    {
+        std::printf ("\nERROR: the profiled run diverged (%u games instead of %u)\n", profiled.games + 1, plain.games + 1);
+
+        return 1;
+    }
+
+    return 0;
+}
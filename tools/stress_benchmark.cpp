@@ -0,0 +1,126 @@
+/*
+ * STRESS BENCHMARK
+ * Copyright © 2022+ Félix Hernández Muñoz-Yusta
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * felixhernandezmy@gmail.com
+ */
+
+// Ejecuta sin gráficos la misma prueba de carga que Stress_Scene: por cada nivel hace aparecer el
+// doble de obstáculos por segundo que en el anterior y muestra lo que cuesta cada paso según el
+// número de obstáculos activos. Los fotogramas del principio de cada nivel (mientras se llena la
+// pantalla) no se cuentan. Así solo se mide la simulación, no el coste de dibujar.
+//
+// Con "scene" como primer argumento ejecuta la propia Stress_Scene mediante el Director con el
+// backend headless de basics y reloj virtual, de modo que también se muestra el tiempo que tarda la
+// escena en enviar los obstáculos al canvas y las llamadas de dibujo que cuenta este (una por
+// primitiva, ver basics::headless::Canvas).
+//
+// Uso: stress-benchmark [scene] [obstáculos por segundo del primer nivel] [niveles] [segundos por nivel]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <basics/Director>
+#include <basics/enable>
+#include <basics/headless/Context>
+#include <basics/headless/Headless>
+#include <basics/Timer>
+
+#include "Obstacle_Stress.hpp"
+#include "Stress_Scene.hpp"
+
+using namespace basics;
+using namespace flythecopter;
+
+namespace
+{
+
+    const float time_step = 1.f / 60.f;
+
+    int run_scene (const Stress_Scene::Levels & levels)
+    {
+        // Se deja un segundo más para que la escena cargue su textura antes del primer nivel:
+
+        const unsigned frames = unsigned(levels.count * levels.duration / time_step) + 60;
+
+        headless::set_asset_path (FLYTHECOPTER_ASSETS_PATH);
+
+        enable< Headless > ();
+
+        director.set_graphics_context_factory (headless::Context::create);
+        director.set_time_step                (time_step);
+        director.set_frame_limit              (frames);
+        director.get_frame_statistics ().set_logging (false);
+
+        std::shared_ptr< Stress_Scene > scene(new Stress_Scene(levels));
+
+        director.run_scene (scene);
+
+        std::printf ("\n%s\n", Obstacle_Stress::Report::header ().c_str ());
+
+        for (const Stress_Scene::Level_Report & level : scene->get_finished_levels ())
+        {
+            std::printf ("%s\n", level.report.line (level.spawn_rate, true).c_str ());
+        }
+
+        if (scene->get_finished_levels ().size () < levels.count)
+        {
+            std::printf ("ERROR: the stress scene finished %u of %u levels\n", unsigned(scene->get_finished_levels ().size ()), levels.count);
+            return 1;
+        }
+
+        return 0;
+    }
+
+}
+
+int main (int number_of_arguments, char * arguments[])
+{
+    bool scene = number_of_arguments > 1 && std::strcmp (arguments[1], "scene") == 0;
+
+    if (scene)
+    {
+        number_of_arguments--;
+        arguments++;
+    }
+
+    float    first_rate = number_of_arguments > 1 ? float   (std::strtod  (arguments[1], nullptr    )) : 500.f;
+    unsigned levels     = number_of_arguments > 2 ? unsigned(std::strtoul (arguments[2], nullptr, 10)) :    6u;
+    float    duration   = number_of_arguments > 3 ? float   (std::strtod  (arguments[3], nullptr    )) :   8.f;
+
+    if (scene) return run_scene ({ first_rate, levels, duration });
+
+    const unsigned frames = unsigned(duration / time_step);
+
+    Obstacle_Stress stress({ 1280.f, 720.f });
+
+    std::printf ("%s\n", Obstacle_Stress::Report::header ().c_str ());
+
+    float rate = first_rate;
+
+    for (unsigned level = 0; level < levels; ++level, rate *= 2.f)
+    {
+        Obstacle_Stress::Report report{};
+
+        stress.set_spawn_rate (rate);
+
+        for (unsigned frame = 0; frame < frames; ++frame)
+        {
+            Timer timer;
+
+            stress.step (time_step);
+
+            double seconds = timer.get_elapsed_seconds< double > ();
+
+            if (frame >= frames / 2) report.add (stress.get_counters (), seconds, 0.0, 0);
+        }
+
+        std::printf ("%s\n", report.line (rate, false).c_str ());
+    }
+
+    return 0;
+}